@@ -0,0 +1,124 @@
+#pragma once
+
+#include "croupier/sdk/runtime.h"
+#include "croupier/sdk/tcp_transport.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace croupier {
+namespace sdk {
+
+/**
+ * @brief Lets a shared Runtime's reactor read a polled transport in place of its own read thread
+ *
+ * The watch ends itself when the connection drops, since the socket is closed with it.
+ */
+class TransportWatch {
+public:
+    static std::shared_ptr<TransportWatch> Start(const std::shared_ptr<Runtime>& runtime, TCPTransport& transport);
+
+    /**
+     * @brief Stop reading; must be called before the transport is closed or destroyed
+     */
+    void Stop();
+
+private:
+    std::weak_ptr<Runtime> runtime_;  // The watch callback holds this object, so no strong reference back
+    std::mutex mutex_;
+    Runtime::SourceId id_ = 0;
+};
+
+struct AgentConnectionConfig {
+    std::string agent_addr = "127.0.0.1:19090";  // Agent address, "host:port" or "tcp://host:port"
+    int timeout_seconds = 30;                    // Per-request timeout
+    int heartbeat_interval = 60;                 // Seconds between heartbeat rounds
+    std::shared_ptr<Runtime> runtime;            // Required: reads, heartbeats and tenant jobs run here
+};
+
+/**
+ * @brief One agent connection multiplexed by several clients and invokers (tenants)
+ *
+ * Set ClientConfig::connection or InvokerConfig::connection to share it. Each client still
+ * registers on its own and keeps its own session; the connection sends the heartbeats of all
+ * sessions together, one batched write per heartbeat_interval, instead of one timer and one write
+ * per client. A dropped connection is re-dialed by the next tenant that needs it.
+ */
+class AgentConnection {
+public:
+    using TenantId = uint64_t;
+    using LostHandler = std::function<void(const std::string& error)>;
+
+    /**
+     * @throws std::runtime_error if no runtime is configured
+     */
+    explicit AgentConnection(const AgentConnectionConfig& config);
+    ~AgentConnection();
+
+    AgentConnection(const AgentConnection&) = delete;
+    AgentConnection& operator=(const AgentConnection&) = delete;
+
+    const std::shared_ptr<Runtime>& GetRuntime() const { return config_.runtime; }
+
+    /**
+     * @brief The shared transport, dialing the agent first if it is not connected
+     * @throws std::runtime_error if the agent cannot be reached
+     */
+    std::shared_ptr<TCPTransport> Acquire();
+
+    /**
+     * @brief Add a tenant; on_lost runs (on a runtime thread) when one of its heartbeats fails
+     *
+     * on_lost must not call RemoveTenant.
+     */
+    TenantId AddTenant(const std::string& service_id, LostHandler on_lost);
+
+    /**
+     * @brief Start heartbeats for the tenant's session, or stop them with an empty session_id
+     */
+    void SetSession(TenantId tenant, const std::string& session_id);
+
+    /**
+     * @brief Remove a tenant; waits for a heartbeat round that is reporting a failure to it
+     */
+    void RemoveTenant(TenantId tenant);
+
+    size_t TenantCount() const;
+
+    /**
+     * @brief Send one heartbeat per tenant session in a single write
+     * @return Number of heartbeats the agent acknowledged
+     */
+    size_t SendHeartbeats();
+
+    /**
+     * @brief Stop heartbeats and close the transport; tenants see their calls fail with UNAVAILABLE
+     */
+    void Close();
+
+private:
+    struct Tenant {
+        std::string service_id;
+        std::string session_id;
+        LostHandler on_lost;
+    };
+
+    AgentConnectionConfig config_;
+    std::string host_;
+    int port_ = 0;
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<TCPTransport> transport_;
+    std::shared_ptr<TransportWatch> watch_;
+    std::map<TenantId, Tenant> tenants_;
+    TenantId next_tenant_id_ = 1;
+    Runtime::SourceId heartbeat_timer_ = 0;  // One timer for all tenants, from construction to Close
+    std::mutex delivery_mutex_;              // Held while on_lost handlers run so RemoveTenant can wait for them
+};
+
+}  // namespace sdk
+}  // namespace croupier
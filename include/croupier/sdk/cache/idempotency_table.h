@@ -0,0 +1,95 @@
+#pragma once
+
+#include "croupier/sdk/croupier_client.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace croupier {
+namespace sdk {
+namespace cache {
+
+/**
+ * @brief Provider-side table that executes each idempotency key at most once per TTL
+ *
+ * The first request for a key runs the handler; a retry that arrives while it is still running
+ * waits for the same result, and one that arrives later gets the stored response. Keys live in
+ * lock-striped shards, each evicting in insertion order, which is also expiry order because every
+ * entry gets the same TTL. Failures are propagated to waiters but not remembered, so a later retry
+ * runs the handler again.
+ */
+class IdempotencyTable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        uint64_t executions = 0;  // Handler runs
+        uint64_t replays = 0;     // Served from a stored response
+        uint64_t joins = 0;       // Waited for an in-flight execution
+        uint64_t evictions = 0;   // Dropped early to respect max_entries
+    };
+
+    explicit IdempotencyTable(const IdempotencyConfig& config);
+
+    bool Enabled() const { return !shards_.empty(); }
+
+    /**
+     * @brief Build the table key for a call; keys are scoped per function
+     */
+    static std::string MakeKey(const std::string& function_id, const std::string& idempotency_key);
+
+    /**
+     * @brief Run fn for key unless it already ran (or is running) within the TTL
+     * @param deduplicated Set to true when fn was not run by this call
+     */
+    std::string Execute(const std::string& key, const std::function<std::string()>& fn,
+                        bool* deduplicated = nullptr, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Number of keys currently remembered (completed or in flight)
+     */
+    size_t Size() const;
+
+    Stats GetStats() const;
+
+private:
+    struct Entry {
+        std::shared_future<std::string> result;
+        Clock::time_point expires_at;
+        uint64_t sequence = 0;  // Distinguishes a re-inserted key from its stale FIFO record
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+        std::deque<std::pair<std::string, uint64_t>> order;  // Insertion (= expiry) order
+        uint64_t next_sequence = 0;
+    };
+
+    Shard& shardFor(const std::string& key);
+    void expireLocked(Shard& shard, Clock::time_point now);
+    void evictOldestLocked(Shard& shard);
+    void forget(Shard& shard, const std::string& key, uint64_t sequence);
+
+    IdempotencyConfig config_;
+    size_t per_shard_capacity_ = 0;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<uint64_t> executions_{0};
+    std::atomic<uint64_t> replays_{0};
+    std::atomic<uint64_t> joins_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
+
+}  // namespace cache
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "croupier/sdk/croupier_client.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace croupier {
+namespace sdk {
+namespace cache {
+
+/**
+ * @brief Bounded cache of read-function results
+ *
+ * Entries are spread over independently locked shards; each shard is a fixed-size ring evicted with
+ * the CLOCK (second chance) policy, so memory stays bounded by max_entries slots whose key and value are each
+ * at most max_value_bytes. Only functions with a positive TTL are cached. Invalidation bumps a per-function
+ * generation instead of walking the shards: entries stored under an older generation are treated as misses and
+ * recycled by CLOCK.
+ */
+class ResultCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    using Stats = CacheStats;
+
+    explicit ResultCache(const ResultCacheConfig& config);
+
+    bool Enabled() const { return config_.enabled; }
+
+    /**
+     * @brief Derive TTLs and invalidation rules from a virtual object's operations and metadata
+     */
+    void RegisterObject(const VirtualObjectDescriptor& desc);
+
+    /**
+     * @brief Set (or clear with ttl_ms <= 0) the TTL of a single function
+     * @param max_value_bytes Per-function size limit; 0 keeps ResultCacheConfig::max_value_bytes
+     */
+    void SetFunctionTTL(const std::string& function_id, int ttl_ms, size_t max_value_bytes = 0);
+
+    /**
+     * @brief Build the cache key for a call (function ID, routing fields, metadata and payload)
+     */
+    static std::string MakeKey(const std::string& function_id, const InvokeOptions& options,
+                               const std::string& payload);
+
+    /**
+     * @brief Look up a cached result
+     * @param generation Receives the function generation to pass to Put on a miss
+     */
+    std::optional<std::string> Get(const std::string& function_id, const std::string& key, uint64_t* generation,
+                                   Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Store a result; ignored if the function is not cacheable, was invalidated since Get, or the key or
+     *        value exceeds max_value_bytes
+     */
+    void Put(const std::string& function_id, const std::string& key, const std::string& value, uint64_t generation,
+             Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Invalidate the reads affected by a completed call to function_id (no-op for reads)
+     */
+    void OnInvoked(const std::string& function_id);
+
+    /**
+     * @brief Drop every cached result of one function
+     */
+    void InvalidateFunction(const std::string& function_id);
+
+    Stats GetStats() const;
+
+private:
+    struct Policy {
+        int ttl_ms = 0;
+        size_t max_value_bytes = 0;  // 0 = config default
+        uint64_t generation = 0;
+    };
+
+    struct Slot {
+        std::string key;
+        std::string value;
+        Clock::time_point expires_at{};
+        uint64_t generation = 0;
+        bool occupied = false;
+        bool referenced = false;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::vector<Slot> slots;
+        std::unordered_map<std::string, size_t> index;
+        size_t hand = 0;
+    };
+
+    Shard& shardFor(const std::string& key);
+    size_t claimSlotLocked(Shard& shard);
+    void releaseSlotLocked(Shard& shard, size_t slot_index);
+
+    ResultCacheConfig config_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    mutable std::mutex policy_mutex_;
+    std::unordered_map<std::string, Policy> policies_;                        // read function -> TTL/generation
+    std::unordered_map<std::string, std::vector<std::string>> invalidates_;  // mutation -> affected reads
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> invalidations_{0};
+};
+
+}  // namespace cache
+}  // namespace sdk
+}  // namespace croupier
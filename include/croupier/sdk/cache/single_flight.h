@@ -0,0 +1,79 @@
+#pragma once
+
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace croupier {
+namespace sdk {
+namespace cache {
+
+/**
+ * @brief Coalesces concurrent calls that share a key into one execution
+ *
+ * The first caller for a key runs the function; callers arriving while it is in flight block on
+ * the same result (or exception) instead of issuing their own request. Nothing is cached once
+ * the call completes.
+ */
+template <typename T>
+class SingleFlight {
+public:
+    /**
+     * @brief Run fn for key, or wait for the in-flight call with the same key
+     * @param shared Set to true when the result came from another caller's execution
+     */
+    template <typename Fn>
+    T Do(const std::string& key, Fn&& fn, bool* shared = nullptr) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = calls_.find(key);
+        if (it != calls_.end()) {
+            std::shared_future<T> pending = it->second;
+            lock.unlock();
+            if (shared) {
+                *shared = true;
+            }
+            return pending.get();
+        }
+
+        std::promise<T> promise;
+        calls_.emplace(key, promise.get_future().share());
+        lock.unlock();
+        if (shared) {
+            *shared = false;
+        }
+
+        try {
+            T value = fn();
+            finish(key);
+            promise.set_value(value);
+            return value;
+        } catch (...) {
+            finish(key);
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    /**
+     * @brief Number of distinct keys currently executing
+     */
+    size_t InFlight() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_.size();
+    }
+
+private:
+    void finish(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        calls_.erase(key);
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_future<T>> calls_;
+};
+
+}  // namespace cache
+}  // namespace sdk
+}  // namespace croupier
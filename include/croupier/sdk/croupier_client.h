@@ -1,11 +1,15 @@
 #pragma once
 
+#include "croupier/sdk/result.h"
+
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace croupier {
@@ -14,10 +18,45 @@ namespace sdk {
 // Forward declarations
 class CroupierClient;
 class CroupierInvoker;
+class Runtime;
+class AgentConnection;
+namespace threading {
+class Dispatcher;
+}
 
 // Function handler type
 using FunctionHandler = std::function<std::string(const std::string& context, const std::string& payload)>;
 
+// Read-only view of an invocation's metadata; the JSON context string is only built if requested
+class CallMetadata {
+public:
+    virtual ~CallMetadata() = default;
+
+    // Value of a single metadata entry, std::nullopt if absent
+    virtual std::optional<std::string_view> Get(std::string_view key) const = 0;
+
+    // Metadata as the JSON object FunctionHandler receives as context (built on first call)
+    virtual const std::string& Json() const = 0;
+};
+
+// Appends handler output straight into the response buffer
+class ResponseWriter {
+public:
+    explicit ResponseWriter(std::string& buffer) : buffer_(buffer) {}
+
+    void Append(std::string_view data) { buffer_.append(data.data(), data.size()); }
+    void Reserve(size_t bytes) { buffer_.reserve(buffer_.size() + bytes); }
+    std::string& Buffer() { return buffer_; }
+
+private:
+    std::string& buffer_;
+};
+
+// Allocation-free handler type: payload is a view into the request, output goes to the writer.
+// Views are only valid for the duration of the call.
+using FunctionViewHandler =
+    std::function<void(const CallMetadata& metadata, std::string_view payload, ResponseWriter& out)>;
+
 // Function descriptor matching proto definition (control.proto)
 struct FunctionDescriptor {
     std::string id;                // function id, e.g. "player.ban"
@@ -36,6 +75,23 @@ struct FunctionDescriptor {
     std::string entity;     // entity type, e.g. "item", "player"
     std::string operation;  // operation type, e.g. "create", "read", "update", "delete"
     bool enabled = true;    // whether this function is currently enabled
+
+    // Provider-side response caching for pure functions (output depends only on the payload).
+    int cache_ttl_ms = 0;                  // > 0 serves repeated payloads from cache for this long
+    size_t cache_max_entry_bytes = 65536;  // Responses larger than this are never cached
+
+    // Run the handler on a dispatcher's thread (e.g. the world thread) instead of the caller's.
+    // The dispatcher must outlive the client and be drained with ProcessQueue() every frame.
+    threading::Dispatcher* dispatcher = nullptr;
+    int dispatch_deadline_ms = 0;  // Reject calls not started this long after arrival; 0 = timeout_seconds
+};
+
+// Hit/miss counters of a result or response cache
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t invalidations = 0;
 };
 
 // Relationship definition for virtual objects
@@ -80,6 +136,17 @@ struct LocalFunctionDescriptor {
     std::string version;  // function version
 };
 
+// Provider-side deduplication of InvokeRequest::idempotency_key.
+// A repeated key for the same function returns the stored response (or waits for the call still
+// running) instead of executing the handler again. Failed calls are not remembered.
+struct IdempotencyConfig {
+    bool enabled = true;                // Deduplicate invocations by idempotency key
+    int ttl_ms = 60000;                 // How long a completed response is replayed
+    size_t max_entries = 10000;         // Upper bound on remembered keys across all shards
+    int shards = 16;                    // Independently locked shards
+    size_t max_response_bytes = 65536;  // Larger responses are not stored for replay
+};
+
 // Client configuration
 struct ClientConfig {
     std::string agent_addr = "127.0.0.1:19090";
@@ -118,8 +185,17 @@ struct ClientConfig {
     std::map<std::string, std::string> headers;  // Additional headers
 
     // ========== Timeouts ==========
-    int timeout_seconds = 30;     // Connection timeout (for blocking connect)
-    int heartbeat_interval = 60;  // Heartbeat interval in seconds
+    int timeout_seconds = 30;               // Connection timeout (for blocking connect)
+    int heartbeat_interval = 60;            // Heartbeat interval in seconds
+    int transport_drain_timeout_ms = 5000;  // Grace period for calls in flight on a replaced agent connection
+
+    // ========== Retry Deduplication ==========
+    IdempotencyConfig idempotency;  // Replay responses for retried invocations
+
+    // ========== Response Cache ==========
+    // Only used when a function sets FunctionDescriptor::cache_ttl_ms
+    size_t response_cache_max_entries = 10000;  // Upper bound on cached responses across all functions
+    int response_cache_shards = 16;             // Independently locked shards
 
     // ========== Connection Mode ==========
     // When true (default), Connect() blocks until connection is established or timeout.
@@ -131,10 +207,29 @@ struct ClientConfig {
     // Shorter than timeout_seconds since retries happen in background via auto_reconnect.
     int connect_timeout_seconds = 5;
 
+    // ========== Event Loop Integration ==========
+    // When true, the client starts no threads of its own. The host loop watches GetEventFd() and calls
+    // ProcessEvents() (or PollOnce()) to run heartbeats, jobs and agent I/O on its own thread.
+    bool external_event_loop = false;
+
+    // ========== Shared Runtime ==========
+    // Run heartbeats, jobs and agent I/O on a Runtime shared with other clients and invokers instead
+    // of threads owned by this client. Ignored when external_event_loop is set.
+    std::shared_ptr<Runtime> runtime;
+    // Register over an agent connection shared with other tenants (agent_addr is then unused); its
+    // runtime is used when runtime is not set, and its heartbeat round covers this client's session.
+    std::shared_ptr<AgentConnection> connection;
+
+    // ========== Dispatcher Handlers (FunctionDescriptor::dispatcher) ==========
+    int dispatch_max_invocations_per_frame = 0;  // Handlers run per dispatcher per ProcessQueue(); 0 = no cap
+
     // ========== Logging Configuration ==========
-    bool disable_logging = false;    // Disable all logging
-    bool debug_logging = false;      // Enable debug level logging
-    std::string log_level = "INFO";  // Log level: "DEBUG", "INFO", "WARN", "ERROR", "OFF"
+    bool disable_logging = false;        // Disable all logging
+    bool debug_logging = false;          // Enable debug level logging
+    std::string log_level = "INFO";      // Log level: "DEBUG", "INFO", "WARN", "ERROR", "OFF"
+    bool async_logging = false;          // Write log lines on a background thread (Logger::StartAsync)
+    int log_rate_limit = 0;              // Lines per second per log statement; 0 = unlimited
+    double log_trace_sample_rate = 1.0;  // Fraction of trace IDs whose per-call lines are logged
 
     // ========== File Transfer Configuration (SECURITY SENSITIVE) ==========
     // File transfer is DISABLED by default for security reasons.
@@ -167,6 +262,54 @@ struct RetryConfig {
     std::vector<int> retryable_status_codes = {14, 13, 2, 10, 4};  // gRPC status codes
 };
 
+// Opt-in retry budget shared by all calls of one invoker; set
+// InvokerConfig::retry_budget.enabled = true to turn it on.
+// Retries are then only allowed while they stay below a fraction of recent successful requests,
+// so a brown-out on the agent side does not get multiplied by max_attempts.
+struct RetryBudgetConfig {
+    bool enabled = false;             // Enable retry budget
+    double retry_ratio = 0.1;         // Retries allowed per successful request in the window (0.1 = 10%)
+    int min_retries_per_second = 10;  // Retry floor so low-traffic callers can still retry
+    int window_seconds = 10;          // Sliding window for successes/retries accounting
+};
+
+// Adaptive (AIMD) concurrency limit applied per target service.
+// Calls beyond the current limit are shed locally instead of queuing on the agent.
+struct ConcurrencyLimitConfig {
+    bool enabled = false;            // Enable adaptive concurrency limiting
+    int initial_limit = 20;          // Starting in-flight limit per target
+    int min_limit = 1;               // Lower bound for the limit
+    int max_limit = 1000;            // Upper bound for the limit
+    double backoff_ratio = 0.9;      // Multiplicative decrease factor on drop/latency inflation
+    double latency_tolerance = 2.0;  // Sample RTT above tolerance * average RTT counts as inflation
+};
+
+// Opt-in circuit breaker keyed by function ID and target service; set
+// InvokerConfig::circuit_breaker.enabled = true to turn it on.
+// While open, calls fail immediately with UNAVAILABLE instead of waiting for timeout_seconds on a broken function.
+struct CircuitBreakerConfig {
+    bool enabled = false;                   // Enable per-function circuit breaking
+    int window_seconds = 10;                // Rolling window for error/latency statistics
+    int minimum_requests = 20;              // Calls required in the window before the breaker can trip
+    double failure_rate_threshold = 0.5;    // Failure ratio (0-1) that opens the circuit
+    int slow_call_threshold_ms = 0;         // Calls slower than this count as slow (0 = disabled)
+    double slow_call_rate_threshold = 0.8;  // Slow-call ratio (0-1) that opens the circuit
+    int open_duration_ms = 5000;            // Time the circuit stays open before probing
+    int half_open_max_probes = 1;           // Concurrent probe calls allowed while half-open
+};
+
+// Opt-in client-side cache for read functions of virtual objects.
+// Per-function TTLs come from VirtualObjectDescriptor::metadata ("cache_ttl_ms" for all read
+// operations of the object, "cache_ttl_ms:<function_id>" to override one function). Calling any
+// non-read operation of the same object invalidates its cached reads.
+struct ResultCacheConfig {
+    bool enabled = false;            // Enable result caching
+    size_t max_entries = 10000;      // Upper bound on cached results across all shards
+    int shards = 16;                 // Independently locked shards
+    size_t max_value_bytes = 65536;  // Larger results (or call keys) are never cached
+    int default_ttl_ms = 0;          // TTL for read operations without cache_ttl_ms (0 = not cached)
+};
+
 // Invoker configuration
 struct InvokerConfig {
     std::string address;  // Server/Agent address
@@ -190,12 +333,28 @@ struct InvokerConfig {
     int timeout_seconds = 30;  // Request timeout
 
     // ========== Retry Configuration ==========
-    RetryConfig retry;  // Retry configuration
+    RetryConfig retry;               // Retry configuration
+    RetryBudgetConfig retry_budget;  // Invoker-wide cap on retries
+
+    // ========== Load Shedding ==========
+    ConcurrencyLimitConfig concurrency_limit;  // Per-target adaptive concurrency limit
+    CircuitBreakerConfig circuit_breaker;      // Per-function fast-fail on broken providers
+
+    // ========== Result Cache ==========
+    ResultCacheConfig cache;         // Read-function result cache (see SetObjectDescriptor)
+    bool coalesce_requests = false;  // Identical concurrent Invoke calls (incl. metadata) share one request
+
+    // ========== Shared Runtime ==========
+    std::shared_ptr<Runtime> runtime;             // Run jobs, stream polling and reconnects here instead of own threads
+    std::shared_ptr<AgentConnection> connection;  // Call over this shared connection instead of dialing address
 
     // ========== Logging Configuration ==========
-    bool disable_logging = false;    // Disable all logging
-    bool debug_logging = false;      // Enable debug level logging
-    std::string log_level = "INFO";  // Log level: "DEBUG", "INFO", "WARN", "ERROR", "OFF"
+    bool disable_logging = false;        // Disable all logging
+    bool debug_logging = false;          // Enable debug level logging
+    std::string log_level = "INFO";      // Log level: "DEBUG", "INFO", "WARN", "ERROR", "OFF"
+    bool async_logging = false;          // Write log lines on a background thread (Logger::StartAsync)
+    int log_rate_limit = 0;              // Lines per second per log statement; 0 = unlimited
+    double log_trace_sample_rate = 1.0;  // Fraction of trace IDs whose per-call lines are logged
 
     // ========== File Transfer Configuration (SECURITY SENSITIVE) ==========
     // File transfer is DISABLED by default for security reasons.
@@ -242,6 +401,13 @@ class CroupierClient {
     // Register a function handler with optional schema
     bool RegisterFunction(const FunctionDescriptor& desc, FunctionHandler handler);
 
+    // Register a zero-copy handler (string_view payload, lazy metadata, appending writer)
+    bool RegisterFunction(const FunctionDescriptor& desc, FunctionViewHandler handler);
+
+    // Remove a function; after Connect the function's handle is retired at once. The agent only accepts the
+    // full catalog, so changes made after Connect are re-registered in the background, batched together.
+    bool UnregisterFunction(const std::string& function_id);
+
     // ========== New Virtual Object Registration ==========
 
     // Register a virtual object with its associated functions
@@ -288,6 +454,31 @@ class CroupierClient {
     // Get local server address after starting
     std::string GetLocalAddress() const;
 
+    // ========== Event Loop Integration (ClientConfig::external_event_loop) ==========
+
+    // Descriptor that becomes readable when ProcessEvents() has queued work; -1 if not in this mode
+    int GetEventFd() const;
+
+    // Milliseconds until the next timer is due (use as the poll timeout), -1 if none is scheduled
+    int NextTimeoutMs() const;
+
+    // Run queued work, agent I/O and due timers without blocking; returns the number of items processed
+    int ProcessEvents();
+
+    // Wait up to timeout_ms for work or the next timer, then ProcessEvents()
+    int PollOnce(int timeout_ms);
+
+    // Serve one request the agent forwards to this provider (MSG_INVOKE_REQUEST, MSG_START_JOB_REQUEST, ...)
+    // and return the encoded reply. The local endpoint started by Connect routes every frame through here.
+    // Throws std::runtime_error for an unsupported or malformed message.
+    std::vector<uint8_t> HandleLocalRequest(uint32_t msg_type, const std::vector<uint8_t>& body);
+
+    // Content hash of the registered function catalog; equal hashes mean nothing to re-register
+    uint64_t GetCatalogHash() const;
+
+    // Counters of the response cache used by functions with cache_ttl_ms
+    CacheStats GetResponseCacheStats() const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
@@ -305,6 +496,11 @@ class CroupierInvoker {
     // Invoke a function synchronously
     std::string Invoke(const std::string& function_id, const std::string& payload, const InvokeOptions& options = {});
 
+    // Invoke a function synchronously without throwing; failures carry a numeric StatusCode
+    // that is matched against RetryConfig::retryable_status_codes
+    Result<std::string> TryInvoke(const std::string& function_id, const std::string& payload,
+                                  const InvokeOptions& options = {});
+
     // Start an async job
     std::string StartJob(const std::string& function_id, const std::string& payload, const InvokeOptions& options = {});
 
@@ -317,6 +513,9 @@ class CroupierInvoker {
     // Set schema for client-side validation
     void SetSchema(const std::string& function_id, const std::map<std::string, std::string>& schema);
 
+    // Register a virtual object so its read operations can be cached and its mutations invalidate them
+    void SetObjectDescriptor(const VirtualObjectDescriptor& desc);
+
     // Set reconnection configuration
     void SetReconnectConfig(const ReconnectConfig& config);
 
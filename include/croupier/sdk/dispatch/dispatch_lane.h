@@ -0,0 +1,83 @@
+#pragma once
+
+#include "croupier/sdk/threading/dispatcher.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace croupier {
+namespace sdk {
+namespace dispatch {
+
+/**
+ * @brief Runs provider handlers on a Dispatcher's thread for callers on other threads
+ *
+ * Calls are queued in the lane and the dispatcher gets one drain callback per frame, not one
+ * per call: each ProcessQueue() of the dispatcher runs the queued handlers as a batch, at most
+ * max_per_frame of them, and defers the rest to the next frame. A call that has not started by
+ * its deadline is rejected without running its handler.
+ */
+class DispatchLane {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Work = std::function<std::string()>;
+
+    /**
+     * @param max_per_frame Handlers to run per ProcessQueue(); 0 or less for no cap
+     */
+    DispatchLane(threading::Dispatcher& dispatcher, int max_per_frame);
+
+    DispatchLane(const DispatchLane&) = delete;
+    DispatchLane& operator=(const DispatchLane&) = delete;
+
+    /**
+     * @brief Run work on the dispatcher's thread and wait for its result
+     *
+     * Runs inline when called on the dispatcher's thread. Work that has started always runs to
+     * completion, even past the deadline.
+     * @throws std::runtime_error if the work did not start before deadline; rethrows what work throws
+     */
+    std::string Run(Work work, Clock::time_point deadline);
+
+    size_t PendingCount() const;
+    uint64_t ExecutedCount() const { return state_->executed.load(std::memory_order_relaxed); }
+    uint64_t RejectedCount() const { return state_->rejected.load(std::memory_order_relaxed); }
+
+private:
+    enum : int { QUEUED, RUNNING, ABANDONED };
+
+    struct Invocation {
+        Work work;
+        Clock::time_point deadline;
+        std::atomic<int> state{QUEUED};  // The caller giving up and the drain starting it race on this
+        std::promise<std::string> result;
+    };
+
+    // Shared with queued drain callbacks, which may outlive the lane
+    struct State {
+        threading::Dispatcher* dispatcher = nullptr;
+        size_t max_per_frame = 0;
+        mutable std::mutex mutex;
+        std::deque<std::shared_ptr<Invocation>> pending;
+        bool drain_queued = false;  // A drain callback is in the dispatcher for this lane
+        uint64_t frame = 0;         // Dispatcher frame the lane last drained in
+        size_t taken_in_frame = 0;  // Calls taken off pending during that frame
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> rejected{0};
+    };
+
+    static void Drain(const std::shared_ptr<State>& state);
+
+    std::shared_ptr<State> state_;
+};
+
+}  // namespace dispatch
+}  // namespace sdk
+}  // namespace croupier
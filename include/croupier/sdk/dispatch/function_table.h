@@ -0,0 +1,92 @@
+#pragma once
+
+#include "croupier/sdk/croupier_client.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace croupier {
+namespace sdk {
+namespace dispatch {
+
+/**
+ * @brief Immutable dispatch table of provider functions
+ *
+ * Entries are stored contiguously and entry N - 1 is the function with handle N. A fresh table is in
+ * function ID order. A table rebuilt from a previous one keeps every surviving function at its old
+ * handle, leaves removed functions as tombstones and appends new ones, so handles already handed
+ * out stay valid when functions are added or removed at runtime.
+ *
+ * Lookup by name goes through an open-addressing index of 8-byte slots (hash tag + entry index) sized
+ * to at most half full: a hit typically costs one probe in the index and one string compare in the
+ * entry array, instead of a string comparison per tree level. Lookup by handle is a direct index.
+ *
+ * Not thread-safe to rebuild; concurrent lookups on a built table are safe.
+ */
+class FunctionTable {
+public:
+    struct Entry {
+        std::string function_id;
+        FunctionHandler handler;                      // Set for string handlers
+        FunctionViewHandler view_handler;             // Set for zero-copy handlers
+        int cache_ttl_ms = 0;                         // From FunctionDescriptor; > 0 enables the response cache
+        threading::Dispatcher* dispatcher = nullptr;  // From FunctionDescriptor; run the handler there
+        int dispatch_deadline_ms = 0;                 // From FunctionDescriptor
+        uint64_t hash = 0;
+
+        // False for the tombstone of a removed function
+        bool Live() const { return handler || view_handler; }
+    };
+
+    FunctionTable() = default;
+    explicit FunctionTable(const std::map<std::string, FunctionHandler>& handlers,
+                           const std::map<std::string, FunctionViewHandler>& view_handlers = {},
+                           const std::map<std::string, FunctionDescriptor>& descriptors = {},
+                           const FunctionTable* previous = nullptr);
+
+    /**
+     * @brief Find a function by ID; nullptr if it is not registered
+     */
+    const Entry* Find(const std::string& function_id) const;
+
+    /**
+     * @brief Find a function by its 1-based handle; nullptr if out of range or removed
+     */
+    const Entry* Get(uint32_t handle) const {
+        if (handle == 0 || handle > entries_.size() || !entries_[handle - 1].Live()) {
+            return nullptr;
+        }
+        return &entries_[handle - 1];
+    }
+
+    /**
+     * @brief Handle of a function ID, 0 if it is not registered
+     */
+    uint32_t HandleOf(const std::string& function_id) const;
+
+    /**
+     * @brief All entries in handle order, including tombstones (see Entry::Live)
+     */
+    const std::vector<Entry>& Entries() const { return entries_; }
+    size_t Size() const { return live_count_; }
+    bool Empty() const { return live_count_ == 0; }
+
+    static uint64_t Hash(const std::string& function_id);
+
+private:
+    struct Slot {
+        uint32_t tag = 0;    // Upper 32 bits of the hash
+        uint32_t entry = 0;  // Entry index + 1; 0 marks an empty slot
+    };
+
+    std::vector<Entry> entries_;
+    size_t live_count_ = 0;
+    std::vector<Slot> slots_;
+    uint64_t mask_ = 0;
+};
+
+}  // namespace dispatch
+}  // namespace sdk
+}  // namespace croupier
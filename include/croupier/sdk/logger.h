@@ -1,13 +1,22 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
-#include <ctime>
-#include <iomanip>
-#include <iostream>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
-#include <regex>
-#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include "croupier/sdk/utils/hash.h"
+
+// Lowest level compiled into the logging macros: 0 = DEBUG, 1 = INFO, 2 = WARN, 3 = ERROR, 4 = OFF.
+// Statements below it cost nothing at runtime, whatever SetLevel() says. Set via CMake.
+#ifndef CROUPIER_LOG_MIN_LEVEL
+#define CROUPIER_LOG_MIN_LEVEL 0
+#endif
 
 // Optional: Use spdlog if available
 // Uncomment to use spdlog instead of simple logger
@@ -43,30 +52,104 @@ inline std::string MaskFully(const std::string& value) {
     return std::string(value.length(), '*');
 }
 
-// Mask JSON value by key (for logging JSON payloads)
+// Masks the string values of sensitive keys in JSON payloads for logging. The key list is
+// compiled once into a hash table; Mask() then tokenizes the document in a single pass without
+// regex or per-key work. A masker is immutable after construction, so one instance can be
+// shared across threads on the request-logging path.
+class JsonMasker {
+public:
+    explicit JsonMasker(const std::vector<std::string>& keys_to_mask);
+
+    // Copy of json with every non-empty string value of a listed key replaced by "***masked***".
+    // Keys match exactly as written in the document, at any nesting depth.
+    std::string Mask(const std::string& json) const;
+
+    // Same as Mask(), appending to out so callers can reuse a buffer
+    void MaskInto(const std::string& json, std::string& out) const;
+
+private:
+    struct Slot {
+        uint64_t hash = 0;
+        std::string key;  // Empty marks a free slot
+    };
+
+    bool isMasked(const char* key, size_t size) const;
+
+    std::vector<Slot> slots_;  // Open addressing, power-of-two size
+    size_t min_key_size_ = 0;
+    size_t max_key_size_ = 0;
+};
+
+// Mask JSON value by key (for logging JSON payloads). Compiles the key list on every call;
+// keep a JsonMasker instead when masking repeatedly with the same keys.
 inline std::string MaskJsonSensitive(const std::string& json, const std::vector<std::string>& keys_to_mask) {
-    std::string result = json;
-    for (const auto& key : keys_to_mask) {
-        std::regex pattern("\"" + key + "\"\\s*:\\s*\"([^\"]+)\"");
-        std::string replacement = "\"" + key + "\":\"" + MaskSensitive("$1") + "\"";
-        // Simple replacement - in production, use a proper JSON parser
-        result = std::regex_replace(result, pattern, "\"" + key + "\":\"***masked***\"");
-    }
-    return result;
+    return JsonMasker(keys_to_mask).Mask(json);
 }
 
+// What Log() does when the async queue is full
+enum class LogOverflow {
+    DROP,   // Discard the record and count it; the writer reports the count
+    BLOCK,  // Wait for the writer to make room
+};
+
+struct AsyncLogConfig {
+    size_t queue_capacity = 8192;                  // Records buffered between callers and the writer
+    LogOverflow overflow = LogOverflow::DROP;      // Full-queue behavior
+    std::chrono::milliseconds flush_interval{50};  // Longest an idle writer sleeps between checks
+};
+
+// Per-statement rate limit: each logging macro expansion owns one of these as a function-local
+// static. At most per_second lines pass in each one-second window; the rest are counted, and the
+// next line that passes carries the count so the output says how much was suppressed.
+class LogSiteLimiter {
+public:
+    // Returns false to suppress the line. On true, suppressed is the number of lines suppressed
+    // since the last line that passed. per_second == 0 disables the limit.
+    bool Allow(uint32_t per_second, uint64_t& suppressed) {
+        suppressed = 0;
+        if (per_second == 0) {
+            return true;
+        }
+        const int64_t second =
+            std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        int64_t window = window_.load(std::memory_order_relaxed);
+        if (second != window && window_.compare_exchange_strong(window, second, std::memory_order_relaxed)) {
+            passed_.store(0, std::memory_order_relaxed);
+        }
+        if (passed_.fetch_add(1, std::memory_order_relaxed) < per_second) {
+            suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+private:
+    std::atomic<int64_t> window_{0};
+    std::atomic<uint32_t> passed_{0};
+    std::atomic<uint64_t> suppressed_{0};
+};
+
 // Simple logger for Croupier SDK
 // Can be configured to use spdlog if CROUPIER_USE_SPDLOG is defined
+//
+// Lines are written synchronously by default. After StartAsync(), Log() only formats the line
+// into a per-thread buffer and hands it to a bounded lock-free queue; a background thread writes
+// queued lines in batches, so a call site never waits on the console or a file.
 class Logger {
 public:
     enum class Level { DEBUG = 0, INFO = 1, WARN = 2, ERR = 3, OFF = 4 };
 
+    // Receives one or more complete, newline-terminated lines per call
+    using Sink = std::function<void(const char* data, size_t size)>;
+
     static Logger& GetInstance() {
         static Logger instance;
         return instance;
     }
 
-    void SetLevel(Level level) { level_ = level; }
+    void SetLevel(Level level) { level_.store(level, std::memory_order_relaxed); }
 
     void SetLevelFromString(const std::string& level) {
         if (level == "DEBUG" || level == "debug") {
@@ -90,44 +173,32 @@ class Logger {
         }
     }
 
-    bool IsEnabled(Level level) const { return level >= level_; }
+    bool IsEnabled(Level level) const { return level >= level_.load(std::memory_order_relaxed); }
 
-    void Log(Level level, const std::string& component, const std::string& message) {
-        if (!IsEnabled(level)) {
-            return;
-        }
-
-        std::lock_guard<std::mutex> lock(mutex_);
+    // True if statements at this level survive CROUPIER_LOG_MIN_LEVEL
+    static constexpr bool IsCompiledIn(Level level) { return static_cast<int>(level) >= CROUPIER_LOG_MIN_LEVEL; }
 
-#ifdef CROUPIER_USE_SPDLOG
-        if (spdlog_logger_) {
-            switch (level) {
-            case Level::DEBUG:
-                spdlog_logger_->debug("[{}] {}", component, message);
-                break;
-            case Level::INFO:
-                spdlog_logger_->info("[{}] {}", component, message);
-                break;
-            case Level::WARN:
-                spdlog_logger_->warn("[{}] {}", component, message);
-                break;
-            case Level::ERR:
-                spdlog_logger_->error("[{}] {}", component, message);
-                break;
-            default:
-                break;
-            }
-            return;
-        }
-#endif
+    // Lines per second each rate-limited statement may write; 0 (the default) for no limit
+    void SetRateLimit(uint32_t lines_per_second) { rate_limit_.store(lines_per_second, std::memory_order_relaxed); }
+    uint32_t RateLimit() const { return rate_limit_.load(std::memory_order_relaxed); }
 
-        // Simple console logging
-        std::string level_str = LevelToString(level);
-        std::string timestamp = GetTimestamp();
+    // Keep trace-tagged lines for this fraction of trace IDs (1.0 keeps all). The decision is a
+    // hash of the trace ID, so a sampled trace keeps all of its lines. Untagged lines are unaffected.
+    void SetTraceSampleRate(double rate) {
+        const double clamped = rate < 0.0 ? 0.0 : (rate > 1.0 ? 1.0 : rate);
+        trace_sample_threshold_.store(static_cast<uint32_t>(clamped * kTraceSampleScale), std::memory_order_relaxed);
+    }
 
-        std::cout << timestamp << " [" << level_str << "] [" << component << "] " << message << std::endl;
+    bool IsTraceSampled(const std::string& trace_id) const {
+        const uint32_t threshold = trace_sample_threshold_.load(std::memory_order_relaxed);
+        if (trace_id.empty() || threshold >= kTraceSampleScale) {
+            return true;
+        }
+        return utils::Fnv1a(trace_id) % kTraceSampleScale < threshold;
     }
 
+    void Log(Level level, const std::string& component, const std::string& message);
+
     // Log with sensitive data masking (for tokens, passwords, etc.)
     void LogMasked(Level level, const std::string& component, const std::string& message,
                    const std::string& sensitive_value) {
@@ -146,64 +217,74 @@ class Logger {
 
     void Error(const std::string& component, const std::string& message) { Log(Level::ERR, component, message); }
 
+    // Replace where lines go (stdout by default); nullptr restores stdout
+    void SetSink(Sink sink);
+
+    // Switch to asynchronous writing. Calling it again while async updates overflow and
+    // flush_interval; queue_capacity takes effect the next time the writer starts.
+    void StartAsync(const AsyncLogConfig& config = AsyncLogConfig());
+
+    // Write everything queued, stop the writer thread and return to synchronous writing
+    void StopAsync();
+
+    bool IsAsync() const { return async_active_.load(std::memory_order_acquire); }
+
+    // Block until every line logged before the call has reached the sink
+    void Flush();
+
+    // Records discarded because the async queue was full
+    uint64_t DroppedCount() const { return dropped_total_.load(std::memory_order_relaxed); }
+
 #ifdef CROUPIER_USE_SPDLOG
     void SetSpdlogLogger(std::shared_ptr<spdlog::logger> logger) { spdlog_logger_ = logger; }
 #endif
 
 private:
-    Logger() : level_(Level::INFO) {
-#ifdef CROUPIER_USE_SPDLOG
-        try {
-            spdlog_logger_ = spdlog::stdout_color_mt("croupier");
-            spdlog_logger_->set_level(spdlog::level::info);
-            spdlog_logger_->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [%n] %v");
-        } catch (const spdlog::spdlog_ex& ex) {
-            std::cerr << "Failed to initialize spdlog: " << ex.what() << std::endl;
-        }
-#endif
-    }
+    class AsyncQueue;
 
-    std::string LevelToString(Level level) const {
-        switch (level) {
-        case Level::DEBUG:
-            return "DEBUG";
-        case Level::INFO:
-            return "INFO";
-        case Level::WARN:
-            return "WARN";
-        case Level::ERR:
-            return "ERROR";
-        default:
-            return "UNKNOWN";
-        }
-    }
+    Logger();
+    ~Logger();
 
-    std::string GetTimestamp() const {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+    void write(const char* data, size_t size);
+    void writerLoop();
 
-        std::stringstream ss;
-        ss << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%S");
-        ss << '.' << std::setfill('0') << std::setw(3) << ms.count() << 'Z';
-        return ss.str();
-    }
+    static constexpr uint32_t kTraceSampleScale = 1000000;
 
-    Level level_;
-    std::mutex mutex_;
+    std::atomic<Level> level_{Level::INFO};
+    std::atomic<uint32_t> rate_limit_{0};
+    std::atomic<uint32_t> trace_sample_threshold_{kTraceSampleScale};
+
+    std::mutex sink_mutex_;  // Serializes sink calls and SetSink
+    Sink sink_;
+
+    std::mutex async_mutex_;             // Serializes StartAsync and StopAsync
+    std::shared_ptr<AsyncQueue> queue_;  // Replaced only while no writer runs and no caller pushes; Flush holds a copy
+    std::atomic<bool> async_active_{false};
+    std::atomic<int> pushing_{0};  // Log() calls that saw async_active_ and may still touch queue_
+    std::atomic<LogOverflow> overflow_{LogOverflow::DROP};
+    std::thread writer_;
+    std::atomic<uint64_t> dropped_total_{0};
+    std::atomic<uint64_t> dropped_unreported_{0};
 #ifdef CROUPIER_USE_SPDLOG
     std::shared_ptr<spdlog::logger> spdlog_logger_;
 #endif
 };
 
-// Convenience macros for logging
-#define CROUPIER_LOG_DEBUG(component, message) croupier::sdk::Logger::GetInstance().Debug(component, message)
+// Convenience macros for logging; statements below CROUPIER_LOG_MIN_LEVEL compile to nothing
+#define CROUPIER_LOG_AT_LEVEL(level, component, message)                              \
+    do {                                                                              \
+        if (croupier::sdk::Logger::IsCompiledIn(croupier::sdk::Logger::Level::level)) \
+            croupier::sdk::Logger::GetInstance().Log(                                 \
+                croupier::sdk::Logger::Level::level, component, message);             \
+    } while (0)
+
+#define CROUPIER_LOG_DEBUG(component, message) CROUPIER_LOG_AT_LEVEL(DEBUG, component, message)
 
-#define CROUPIER_LOG_INFO(component, message) croupier::sdk::Logger::GetInstance().Info(component, message)
+#define CROUPIER_LOG_INFO(component, message) CROUPIER_LOG_AT_LEVEL(INFO, component, message)
 
-#define CROUPIER_LOG_WARN(component, message) croupier::sdk::Logger::GetInstance().Warn(component, message)
+#define CROUPIER_LOG_WARN(component, message) CROUPIER_LOG_AT_LEVEL(WARN, component, message)
 
-#define CROUPIER_LOG_ERROR(component, message) croupier::sdk::Logger::GetInstance().Error(component, message)
+#define CROUPIER_LOG_ERROR(component, message) CROUPIER_LOG_AT_LEVEL(ERR, component, message)
 
 // Convenience macro for logging with masked sensitive value
 #define CROUPIER_LOG_INFO_MASKED(component, message, sensitive_value)                                      \
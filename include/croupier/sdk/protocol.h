@@ -167,86 +167,142 @@ inline ParsedMessage ParseMessage(const std::vector<uint8_t>& data) {
     return result;
 }
 
+/**
+ * Message kinds. Streams answer a request with event messages in place of a response.
+ */
+enum class MsgKind : uint8_t { REQUEST, RESPONSE, EVENT };
+
+/**
+ * Registry entry describing one MsgID.
+ */
+struct MsgInfo {
+    uint32_t id;
+    const char* name;
+    MsgKind kind;
+};
+
+/**
+ * Every MsgID known to the SDK. Name lookup and the consistency checks below
+ * are derived from this table at compile time.
+ */
+inline constexpr MsgInfo MSG_REGISTRY[] = {
+    {MSG_REGISTER_REQUEST, "RegisterRequest", MsgKind::REQUEST},
+    {MSG_REGISTER_RESPONSE, "RegisterResponse", MsgKind::RESPONSE},
+    {MSG_HEARTBEAT_REQUEST, "HeartbeatRequest", MsgKind::REQUEST},
+    {MSG_HEARTBEAT_RESPONSE, "HeartbeatResponse", MsgKind::RESPONSE},
+    {MSG_REGISTER_CAPABILITIES_REQ, "RegisterCapabilitiesRequest", MsgKind::REQUEST},
+    {MSG_REGISTER_CAPABILITIES_RESP, "RegisterCapabilitiesResponse", MsgKind::RESPONSE},
+    {MSG_REGISTER_CLIENT_REQUEST, "RegisterClientRequest", MsgKind::REQUEST},
+    {MSG_REGISTER_CLIENT_RESPONSE, "RegisterClientResponse", MsgKind::RESPONSE},
+    {MSG_CLIENT_HEARTBEAT_REQUEST, "ClientHeartbeatRequest", MsgKind::REQUEST},
+    {MSG_CLIENT_HEARTBEAT_RESPONSE, "ClientHeartbeatResponse", MsgKind::RESPONSE},
+    {MSG_LIST_CLIENTS_REQUEST, "ListClientsRequest", MsgKind::REQUEST},
+    {MSG_LIST_CLIENTS_RESPONSE, "ListClientsResponse", MsgKind::RESPONSE},
+    {MSG_GET_JOB_RESULT_REQUEST, "GetJobResultRequest", MsgKind::REQUEST},
+    {MSG_GET_JOB_RESULT_RESPONSE, "GetJobResultResponse", MsgKind::RESPONSE},
+    {MSG_INVOKE_REQUEST, "InvokeRequest", MsgKind::REQUEST},
+    {MSG_INVOKE_RESPONSE, "InvokeResponse", MsgKind::RESPONSE},
+    {MSG_START_JOB_REQUEST, "StartJobRequest", MsgKind::REQUEST},
+    {MSG_START_JOB_RESPONSE, "StartJobResponse", MsgKind::RESPONSE},
+    {MSG_STREAM_JOB_REQUEST, "StreamJobRequest", MsgKind::REQUEST},
+    {MSG_JOB_EVENT, "JobEvent", MsgKind::EVENT},
+    {MSG_CANCEL_JOB_REQUEST, "CancelJobRequest", MsgKind::REQUEST},
+    {MSG_CANCEL_JOB_RESPONSE, "CancelJobResponse", MsgKind::RESPONSE},
+    {MSG_GET_SYSTEM_INFO_REQUEST, "GetSystemInfoRequest", MsgKind::REQUEST},
+    {MSG_GET_SYSTEM_INFO_RESPONSE, "GetSystemInfoResponse", MsgKind::RESPONSE},
+    {MSG_LIST_PROCESSES_REQUEST, "ListProcessesRequest", MsgKind::REQUEST},
+    {MSG_LIST_PROCESSES_RESPONSE, "ListProcessesResponse", MsgKind::RESPONSE},
+    {MSG_REPORT_METRICS_REQUEST, "ReportMetricsRequest", MsgKind::REQUEST},
+    {MSG_REPORT_METRICS_RESPONSE, "ReportMetricsResponse", MsgKind::RESPONSE},
+    {MSG_STREAM_METRICS_REQUEST, "StreamMetricsRequest", MsgKind::REQUEST},
+    {MSG_METRIC_EVENT, "MetricEvent", MsgKind::EVENT},
+    {MSG_RESTART_PROCESS_REQUEST, "RestartProcessRequest", MsgKind::REQUEST},
+    {MSG_RESTART_PROCESS_RESPONSE, "RestartProcessResponse", MsgKind::RESPONSE},
+    {MSG_STOP_PROCESS_REQUEST, "StopProcessRequest", MsgKind::REQUEST},
+    {MSG_STOP_PROCESS_RESPONSE, "StopProcessResponse", MsgKind::RESPONSE},
+    {MSG_START_PROCESS_REQUEST, "StartProcessRequest", MsgKind::REQUEST},
+    {MSG_START_PROCESS_RESPONSE, "StartProcessResponse", MsgKind::RESPONSE},
+    {MSG_EXECUTE_COMMAND_REQUEST, "ExecuteCommandRequest", MsgKind::REQUEST},
+    {MSG_EXECUTE_COMMAND_RESPONSE, "ExecuteCommandResponse", MsgKind::RESPONSE},
+    {MSG_LIST_SERVICES_REQUEST, "ListServicesRequest", MsgKind::REQUEST},
+    {MSG_LIST_SERVICES_RESPONSE, "ListServicesResponse", MsgKind::RESPONSE},
+    {MSG_GET_SERVICE_STATUS_REQUEST, "GetServiceStatusRequest", MsgKind::REQUEST},
+    {MSG_GET_SERVICE_STATUS_RESPONSE, "GetServiceStatusResponse", MsgKind::RESPONSE},
+    {MSG_REGISTER_LOCAL_REQUEST, "RegisterLocalRequest", MsgKind::REQUEST},
+    {MSG_REGISTER_LOCAL_RESPONSE, "RegisterLocalResponse", MsgKind::RESPONSE},
+    {MSG_HEARTBEAT_LOCAL_REQUEST, "HeartbeatLocalRequest", MsgKind::REQUEST},
+    {MSG_HEARTBEAT_LOCAL_RESPONSE, "HeartbeatLocalResponse", MsgKind::RESPONSE},
+    {MSG_LIST_LOCAL_REQUEST, "ListLocalRequest", MsgKind::REQUEST},
+    {MSG_LIST_LOCAL_RESPONSE, "ListLocalResponse", MsgKind::RESPONSE},
+};
+
+/**
+ * Look up a MsgID in the registry; nullptr for unknown IDs.
+ */
+constexpr const MsgInfo* FindMsgInfo(uint32_t msg_id) {
+    for (const MsgInfo& info : MSG_REGISTRY) {
+        if (info.id == msg_id) {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
 /**
  * Check if the MsgID indicates a request message.
  */
-inline bool IsRequest(uint32_t msg_id) {
+constexpr bool IsRequest(uint32_t msg_id) {
     return msg_id % 2 == 1 && msg_id != MSG_JOB_EVENT && msg_id != MSG_METRIC_EVENT;
 }
 
 /**
  * Check if the MsgID indicates a response message.
  */
-inline bool IsResponse(uint32_t msg_id) {
+constexpr bool IsResponse(uint32_t msg_id) {
     return msg_id % 2 == 0 && msg_id != MSG_JOB_EVENT && msg_id != MSG_METRIC_EVENT;
 }
 
 /**
  * Get the response MsgID for a given request MsgID.
  */
-inline uint32_t GetResponseMsgID(uint32_t req_msg_id) {
+constexpr uint32_t GetResponseMsgID(uint32_t req_msg_id) {
     return req_msg_id + 1;
 }
 
+namespace detail {
+
+constexpr bool RegistryIsConsistent() {
+    for (const MsgInfo& info : MSG_REGISTRY) {
+        if (FindMsgInfo(info.id) != &info || (info.id >> 24) != 0) {
+            return false;  // Duplicate ID or wider than 24 bits
+        }
+        if (info.kind == MsgKind::REQUEST && !IsRequest(info.id)) {
+            return false;
+        }
+        if (info.kind == MsgKind::RESPONSE && !IsResponse(info.id)) {
+            return false;
+        }
+        if (info.kind == MsgKind::REQUEST && FindMsgInfo(GetResponseMsgID(info.id)) == nullptr) {
+            return false;  // Every request needs a registered reply
+        }
+    }
+    return true;
+}
+
+static_assert(RegistryIsConsistent(), "MSG_REGISTRY has a duplicate, mis-numbered or unpaired MsgID");
+
+}  // namespace detail
+
 /**
  * Get human-readable string for MsgID.
  */
 inline std::string MsgIDString(uint32_t msg_id) {
-    switch (msg_id) {
-        case MSG_REGISTER_REQUEST: return "RegisterRequest";
-        case MSG_REGISTER_RESPONSE: return "RegisterResponse";
-        case MSG_HEARTBEAT_REQUEST: return "HeartbeatRequest";
-        case MSG_HEARTBEAT_RESPONSE: return "HeartbeatResponse";
-        case MSG_REGISTER_CAPABILITIES_REQ: return "RegisterCapabilitiesRequest";
-        case MSG_REGISTER_CAPABILITIES_RESP: return "RegisterCapabilitiesResponse";
-        case MSG_REGISTER_CLIENT_REQUEST: return "RegisterClientRequest";
-        case MSG_REGISTER_CLIENT_RESPONSE: return "RegisterClientResponse";
-        case MSG_CLIENT_HEARTBEAT_REQUEST: return "ClientHeartbeatRequest";
-        case MSG_CLIENT_HEARTBEAT_RESPONSE: return "ClientHeartbeatResponse";
-        case MSG_LIST_CLIENTS_REQUEST: return "ListClientsRequest";
-        case MSG_LIST_CLIENTS_RESPONSE: return "ListClientsResponse";
-        case MSG_GET_JOB_RESULT_REQUEST: return "GetJobResultRequest";
-        case MSG_GET_JOB_RESULT_RESPONSE: return "GetJobResultResponse";
-        case MSG_INVOKE_REQUEST: return "InvokeRequest";
-        case MSG_INVOKE_RESPONSE: return "InvokeResponse";
-        case MSG_START_JOB_REQUEST: return "StartJobRequest";
-        case MSG_START_JOB_RESPONSE: return "StartJobResponse";
-        case MSG_STREAM_JOB_REQUEST: return "StreamJobRequest";
-        case MSG_JOB_EVENT: return "JobEvent";
-        case MSG_CANCEL_JOB_REQUEST: return "CancelJobRequest";
-        case MSG_CANCEL_JOB_RESPONSE: return "CancelJobResponse";
-        case MSG_GET_SYSTEM_INFO_REQUEST: return "GetSystemInfoRequest";
-        case MSG_GET_SYSTEM_INFO_RESPONSE: return "GetSystemInfoResponse";
-        case MSG_LIST_PROCESSES_REQUEST: return "ListProcessesRequest";
-        case MSG_LIST_PROCESSES_RESPONSE: return "ListProcessesResponse";
-        case MSG_REPORT_METRICS_REQUEST: return "ReportMetricsRequest";
-        case MSG_REPORT_METRICS_RESPONSE: return "ReportMetricsResponse";
-        case MSG_STREAM_METRICS_REQUEST: return "StreamMetricsRequest";
-        case MSG_METRIC_EVENT: return "MetricEvent";
-        case MSG_RESTART_PROCESS_REQUEST: return "RestartProcessRequest";
-        case MSG_RESTART_PROCESS_RESPONSE: return "RestartProcessResponse";
-        case MSG_STOP_PROCESS_REQUEST: return "StopProcessRequest";
-        case MSG_STOP_PROCESS_RESPONSE: return "StopProcessResponse";
-        case MSG_START_PROCESS_REQUEST: return "StartProcessRequest";
-        case MSG_START_PROCESS_RESPONSE: return "StartProcessResponse";
-        case MSG_EXECUTE_COMMAND_REQUEST: return "ExecuteCommandRequest";
-        case MSG_EXECUTE_COMMAND_RESPONSE: return "ExecuteCommandResponse";
-        case MSG_LIST_SERVICES_REQUEST: return "ListServicesRequest";
-        case MSG_LIST_SERVICES_RESPONSE: return "ListServicesResponse";
-        case MSG_GET_SERVICE_STATUS_REQUEST: return "GetServiceStatusRequest";
-        case MSG_GET_SERVICE_STATUS_RESPONSE: return "GetServiceStatusResponse";
-        case MSG_REGISTER_LOCAL_REQUEST: return "RegisterLocalRequest";
-        case MSG_REGISTER_LOCAL_RESPONSE: return "RegisterLocalResponse";
-        case MSG_HEARTBEAT_LOCAL_REQUEST: return "HeartbeatLocalRequest";
-        case MSG_HEARTBEAT_LOCAL_RESPONSE: return "HeartbeatLocalResponse";
-        case MSG_LIST_LOCAL_REQUEST: return "ListLocalRequest";
-        case MSG_LIST_LOCAL_RESPONSE: return "ListLocalResponse";
-        default: {
-            std::ostringstream stream;
-            stream << "Unknown(0x" << std::uppercase << std::hex << msg_id << ")";
-            return stream.str();
-        }
+    if (const MsgInfo* info = FindMsgInfo(msg_id)) {
+        return info->name;
     }
+    std::ostringstream stream;
+    stream << "Unknown(0x" << std::uppercase << std::hex << msg_id << ")";
+    return stream.str();
 }
 
 }  // namespace protocol
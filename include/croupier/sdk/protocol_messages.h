@@ -0,0 +1,137 @@
+/**
+ * @file protocol_messages.h
+ * @brief Compile-time binding of protocol MsgIDs to their protobuf message types.
+ *
+ * MessageTraits<MSG_X> names the request and reply types of a request MsgID.
+ * Call<MSG_X>() and Dispatch<MSG_X>() are generated from it, so encode/decode
+ * glue is written once and each message type gets its own inlined path.
+ */
+
+#ifndef CROUPIER_SDK_PROTOCOL_MESSAGES_H
+#define CROUPIER_SDK_PROTOCOL_MESSAGES_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "croupier/sdk/v1/invocation.pb.h"
+#include "croupier/sdk/v1/provider.pb.h"
+#include "protocol.h"
+#include "tcp_transport.h"
+
+namespace croupier {
+namespace sdk {
+namespace protocol {
+
+/**
+ * Request/reply types of a request MsgID. Reply is void for requests
+ * answered with an empty body.
+ */
+template <uint32_t MsgId>
+struct MessageTraits;
+
+#define CROUPIER_BIND_MESSAGE(MSG_ID, REQUEST_TYPE, REPLY_TYPE)                                        \
+    template <>                                                                                        \
+    struct MessageTraits<MSG_ID> {                                                                     \
+        static_assert(FindMsgInfo(MSG_ID) && FindMsgInfo(MSG_ID)->kind == MsgKind::REQUEST,            \
+                      #MSG_ID " must be a registered request MsgID");                                  \
+        using Request = REQUEST_TYPE;                                                                  \
+        using Reply = REPLY_TYPE;                                                                      \
+        static constexpr uint32_t kRequestId = MSG_ID;                                                 \
+        static constexpr uint32_t kReplyId = GetResponseMsgID(MSG_ID);                                 \
+    }
+
+CROUPIER_BIND_MESSAGE(MSG_INVOKE_REQUEST, v1::InvokeRequest, v1::InvokeResponse);
+CROUPIER_BIND_MESSAGE(MSG_START_JOB_REQUEST, v1::InvokeRequest, v1::StartJobResponse);
+CROUPIER_BIND_MESSAGE(MSG_STREAM_JOB_REQUEST, v1::JobStreamRequest, v1::JobEvent);
+CROUPIER_BIND_MESSAGE(MSG_CANCEL_JOB_REQUEST, v1::CancelJobRequest, void);
+CROUPIER_BIND_MESSAGE(MSG_GET_JOB_RESULT_REQUEST, v1::GetJobResultRequest, v1::GetJobResultResponse);
+CROUPIER_BIND_MESSAGE(MSG_REGISTER_LOCAL_REQUEST, v1::RegisterLocalRequest, v1::RegisterLocalResponse);
+CROUPIER_BIND_MESSAGE(MSG_HEARTBEAT_LOCAL_REQUEST, v1::HeartbeatRequest, v1::HeartbeatResponse);
+CROUPIER_BIND_MESSAGE(MSG_LIST_LOCAL_REQUEST, v1::ListLocalRequest, v1::ListLocalResponse);
+
+#undef CROUPIER_BIND_MESSAGE
+
+/**
+ * Tag type used to select a per-MsgID handler overload.
+ */
+template <uint32_t MsgId>
+struct MsgTag {
+    static constexpr uint32_t value = MsgId;
+};
+
+/**
+ * Serialize a message straight into a frame body (no intermediate string).
+ */
+template <typename Message>
+std::vector<uint8_t> EncodeBody(const Message& message) {
+    std::vector<uint8_t> body(message.ByteSizeLong());
+    if (!body.empty()) {
+        message.SerializeWithCachedSizesToArray(body.data());
+    }
+    return body;
+}
+
+/**
+ * Parse a frame body into message; throws std::runtime_error naming the MsgID on failure.
+ */
+template <typename Message>
+void DecodeBody(uint32_t msg_id, const std::vector<uint8_t>& body, Message* message) {
+    if (!message->ParseFromArray(body.data(), static_cast<int>(body.size()))) {
+        throw std::runtime_error("failed to parse protobuf message: " + MsgIDString(msg_id));
+    }
+}
+
+/**
+ * Send a typed request and decode its reply.
+ */
+template <uint32_t MsgId>
+typename MessageTraits<MsgId>::Reply Call(TCPTransport& transport,
+                                          const typename MessageTraits<MsgId>::Request& request) {
+    using Traits = MessageTraits<MsgId>;
+    auto response = transport.Call(MsgId, EncodeBody(request));
+    if constexpr (!std::is_void_v<typename Traits::Reply>) {
+        typename Traits::Reply reply;
+        DecodeBody(Traits::kReplyId, response.second, &reply);
+        return reply;
+    }
+}
+
+/**
+ * Decode a request body, run handler(MsgTag<MsgId>, request) and encode its reply.
+ */
+template <uint32_t MsgId, typename Handler>
+std::vector<uint8_t> Dispatch(const std::vector<uint8_t>& body, Handler&& handler) {
+    using Traits = MessageTraits<MsgId>;
+    typename Traits::Request request;
+    DecodeBody(MsgId, body, &request);
+    if constexpr (std::is_void_v<typename Traits::Reply>) {
+        std::forward<Handler>(handler)(MsgTag<MsgId>{}, request);
+        return {};
+    } else {
+        return EncodeBody(std::forward<Handler>(handler)(MsgTag<MsgId>{}, request));
+    }
+}
+
+/**
+ * Route msg_id to the first matching MsgIds entry; the switch is expanded at
+ * compile time. Throws std::runtime_error for unsupported messages.
+ */
+template <uint32_t... MsgIds, typename Handler>
+std::vector<uint8_t> DispatchAny(uint32_t msg_id, const std::vector<uint8_t>& body, Handler&& handler) {
+    std::vector<uint8_t> reply;
+    const bool handled = ((msg_id == MsgIds ? (reply = Dispatch<MsgIds>(body, handler), true) : false) || ...);
+    if (!handled) {
+        throw std::runtime_error("unsupported message: " + MsgIDString(msg_id));
+    }
+    return reply;
+}
+
+}  // namespace protocol
+}  // namespace sdk
+}  // namespace croupier
+
+#endif  // CROUPIER_SDK_PROTOCOL_MESSAGES_H
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "croupier/sdk/croupier_client.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace croupier {
+namespace sdk {
+namespace registry {
+
+/**
+ * @brief Difference between two catalogs, by function ID
+ */
+struct CatalogDelta {
+    std::vector<std::string> added;
+    std::vector<std::string> changed;
+    std::vector<std::string> removed;
+
+    bool Empty() const { return added.empty() && changed.empty() && removed.empty(); }
+};
+
+/**
+ * @brief Content fingerprints of the functions a provider registers
+ *
+ * Each descriptor is reduced to a 64-bit fingerprint of every field sent to the agent, and the
+ * catalog hash combines all (ID, fingerprint) pairs in ID order. Comparing the hash with the last
+ * catalog the agent acknowledged tells whether a re-registration is needed at all; Diff names the
+ * functions that differ.
+ */
+class FunctionCatalog {
+public:
+    static uint64_t Fingerprint(const FunctionDescriptor& desc);
+
+    void Set(const FunctionDescriptor& desc);
+    void Remove(const std::string& function_id);
+    void Clear();
+
+    uint64_t Hash() const;
+    size_t Size() const { return fingerprints_.size(); }
+    bool Empty() const { return fingerprints_.empty(); }
+
+    /**
+     * @brief Functions added, changed or removed relative to base
+     */
+    CatalogDelta Diff(const FunctionCatalog& base) const;
+
+private:
+    std::map<std::string, uint64_t> fingerprints_;
+};
+
+}  // namespace registry
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "croupier/sdk/croupier_client.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace croupier {
+namespace sdk {
+namespace resilience {
+
+/**
+ * @brief Circuit breaker for one (function, target) pair
+ *
+ * CLOSED    - calls pass through; outcomes are collected in a rolling per-second window.
+ * OPEN      - entered when the failure (or slow-call) ratio crosses its threshold after at least
+ *             minimum_requests calls; every call is rejected until open_duration_ms elapses.
+ * HALF_OPEN - up to half_open_max_probes probe calls are let through. All probes succeeding
+ *             closes the circuit, any probe failing opens it again.
+ */
+class CircuitBreaker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class State { CLOSED, OPEN, HALF_OPEN };
+
+    explicit CircuitBreaker(const CircuitBreakerConfig& config);
+
+    /**
+     * @brief Check whether a call may proceed; must be paired with RecordSuccess/RecordFailure
+     */
+    bool AllowRequest(Clock::time_point now = Clock::now());
+
+    void RecordSuccess(Clock::duration latency, Clock::time_point now = Clock::now());
+
+    void RecordFailure(Clock::time_point now = Clock::now());
+
+    State GetState(Clock::time_point now = Clock::now());
+
+private:
+    struct Bucket {
+        int64_t second = -1;
+        int64_t calls = 0;
+        int64_t failures = 0;
+        int64_t slow = 0;
+    };
+
+    Bucket& currentBucket(Clock::time_point now);
+    void evaluateLocked(Clock::time_point now);
+    void transitionLocked(State state, Clock::time_point now);
+    void refreshLocked(Clock::time_point now);
+
+    CircuitBreakerConfig config_;
+    State state_ = State::CLOSED;
+    Clock::time_point opened_at_{};
+    int probes_in_flight_ = 0;
+    int probe_successes_ = 0;
+    std::vector<Bucket> buckets_;
+    std::mutex mutex_;
+};
+
+/**
+ * @brief Registry of breakers keyed by function ID and target service
+ */
+class CircuitBreakerRegistry {
+public:
+    explicit CircuitBreakerRegistry(const CircuitBreakerConfig& config) : config_(config) {}
+
+    /**
+     * @brief Get (or lazily create) the breaker for a function/target; nullptr when disabled
+     */
+    std::shared_ptr<CircuitBreaker> For(const std::string& function_id, const std::string& target);
+
+private:
+    CircuitBreakerConfig config_;
+    std::unordered_map<std::string, std::shared_ptr<CircuitBreaker>> breakers_;
+    std::mutex mutex_;
+};
+
+std::string CircuitStateToString(CircuitBreaker::State state);
+
+}  // namespace resilience
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "croupier/sdk/croupier_client.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace croupier {
+namespace sdk {
+namespace resilience {
+
+/**
+ * @brief AIMD concurrency limiter for a single target
+ *
+ * Tracks in-flight calls against an adaptive limit:
+ * - a successful call whose RTT stays within latency_tolerance of the baseline RTT grows the
+ *   limit additively (+1 per limit's worth of samples, i.e. about +1 per round trip);
+ * - a dropped call (timeout / connection failure) or an inflated RTT shrinks it multiplicatively,
+ *   at most once per limit's worth of samples (about one round trip), not once per sample.
+ *
+ * RTT inflation is measured against a long-window average of all samples, gradient-style, so the
+ * limiter reacts to latency relative to the target's recent behaviour. A lasting latency change
+ * (a slower target, a heavier payload mix) becomes the new normal within about 50 samples.
+ */
+class AdaptiveConcurrencyLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit AdaptiveConcurrencyLimiter(const ConcurrencyLimitConfig& config);
+
+    /**
+     * @brief Try to reserve a slot for a new call
+     *
+     * @return false if the call should be shed
+     */
+    bool TryAcquire();
+
+    /**
+     * @brief Release a slot after a successful call and feed its RTT to the algorithm
+     */
+    void OnSuccess(Clock::duration rtt);
+
+    /**
+     * @brief Release a slot after a call that timed out or lost its connection
+     */
+    void OnDropped();
+
+    /**
+     * @brief Release a slot without adjusting the limit (e.g. application-level errors)
+     */
+    void OnIgnored();
+
+    int GetLimit() const;
+    int GetInFlight() const;
+
+private:
+    void releaseLocked();
+    bool startSampleLocked();  // True while samples are still ignored after the last decrease
+    void decreaseLocked(bool cooling_down);
+
+    ConcurrencyLimitConfig config_;
+    double limit_;
+    int in_flight_ = 0;
+    double long_rtt_us_ = 0.0;
+    int cooldown_samples_ = 0;
+    mutable std::mutex mutex_;
+};
+
+/**
+ * @brief Registry of per-target limiters sharing one configuration
+ */
+class ConcurrencyLimiterRegistry {
+public:
+    explicit ConcurrencyLimiterRegistry(const ConcurrencyLimitConfig& config) : config_(config) {}
+
+    /**
+     * @brief Get (or lazily create) the limiter for a target; nullptr when limiting is disabled
+     */
+    std::shared_ptr<AdaptiveConcurrencyLimiter> ForTarget(const std::string& target);
+
+private:
+    ConcurrencyLimitConfig config_;
+    std::unordered_map<std::string, std::shared_ptr<AdaptiveConcurrencyLimiter>> limiters_;
+    std::mutex mutex_;
+};
+
+}  // namespace resilience
+}  // namespace sdk
+}  // namespace croupier
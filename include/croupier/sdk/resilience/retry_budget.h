@@ -0,0 +1,67 @@
+#pragma once
+
+#include "croupier/sdk/croupier_client.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace croupier {
+namespace sdk {
+namespace resilience {
+
+/**
+ * @brief Retry budget over a sliding time window
+ *
+ * Every successful request deposits into the budget and every retry withdraws from it.
+ * A retry is granted only while
+ *   retries_in_window < min_retries_per_second * window_seconds + retry_ratio * successes_in_window
+ * so the extra load caused by retries stays a bounded fraction of healthy traffic.
+ *
+ * Thread-safe; one instance is shared by all calls of an invoker.
+ */
+class RetryBudget {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RetryBudget(const RetryBudgetConfig& config);
+
+    /**
+     * @brief Record a successful request
+     */
+    void RecordSuccess(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Try to spend one retry from the budget
+     *
+     * @return true if the retry is allowed (and has been accounted for)
+     */
+    bool TryAcquireRetry(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Number of retries that could still be granted right now
+     */
+    int64_t Available(Clock::time_point now = Clock::now());
+
+    const RetryBudgetConfig& GetConfig() const { return config_; }
+
+private:
+    struct Bucket {
+        int64_t second = -1;
+        int64_t successes = 0;
+        int64_t retries = 0;
+    };
+
+    Bucket& currentBucket(Clock::time_point now);
+    int64_t availableLocked(Clock::time_point now) const;
+    int64_t toSecond(Clock::time_point now) const;
+
+    RetryBudgetConfig config_;
+    std::vector<Bucket> buckets_;
+    mutable std::mutex mutex_;
+};
+
+}  // namespace resilience
+}  // namespace sdk
+}  // namespace croupier
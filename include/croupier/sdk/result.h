@@ -0,0 +1,150 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace croupier {
+namespace sdk {
+
+/**
+ * @brief Numeric status codes (gRPC numbering, as used by RetryConfig::retryable_status_codes)
+ */
+enum class StatusCode : int {
+    OK = 0,
+    CANCELLED = 1,
+    UNKNOWN = 2,
+    INVALID_ARGUMENT = 3,
+    DEADLINE_EXCEEDED = 4,
+    NOT_FOUND = 5,
+    ALREADY_EXISTS = 6,
+    PERMISSION_DENIED = 7,
+    RESOURCE_EXHAUSTED = 8,
+    FAILED_PRECONDITION = 9,
+    ABORTED = 10,
+    OUT_OF_RANGE = 11,
+    UNIMPLEMENTED = 12,
+    INTERNAL = 13,
+    UNAVAILABLE = 14,
+    DATA_LOSS = 15,
+    UNAUTHENTICATED = 16,
+};
+
+inline const char* StatusCodeToString(StatusCode code) {
+    switch (code) {
+    case StatusCode::OK:
+        return "OK";
+    case StatusCode::CANCELLED:
+        return "CANCELLED";
+    case StatusCode::UNKNOWN:
+        return "UNKNOWN";
+    case StatusCode::INVALID_ARGUMENT:
+        return "INVALID_ARGUMENT";
+    case StatusCode::DEADLINE_EXCEEDED:
+        return "DEADLINE_EXCEEDED";
+    case StatusCode::NOT_FOUND:
+        return "NOT_FOUND";
+    case StatusCode::ALREADY_EXISTS:
+        return "ALREADY_EXISTS";
+    case StatusCode::PERMISSION_DENIED:
+        return "PERMISSION_DENIED";
+    case StatusCode::RESOURCE_EXHAUSTED:
+        return "RESOURCE_EXHAUSTED";
+    case StatusCode::FAILED_PRECONDITION:
+        return "FAILED_PRECONDITION";
+    case StatusCode::ABORTED:
+        return "ABORTED";
+    case StatusCode::OUT_OF_RANGE:
+        return "OUT_OF_RANGE";
+    case StatusCode::UNIMPLEMENTED:
+        return "UNIMPLEMENTED";
+    case StatusCode::INTERNAL:
+        return "INTERNAL";
+    case StatusCode::UNAVAILABLE:
+        return "UNAVAILABLE";
+    case StatusCode::DATA_LOSS:
+        return "DATA_LOSS";
+    case StatusCode::UNAUTHENTICATED:
+        return "UNAUTHENTICATED";
+    }
+    return "UNKNOWN";
+}
+
+/**
+ * @brief Error value carried by Result: a numeric status code plus a human readable message
+ */
+struct Error {
+    StatusCode code = StatusCode::UNKNOWN;
+    std::string message;
+
+    Error() = default;
+    Error(StatusCode c, std::string msg) : code(c), message(std::move(msg)) {}
+
+    int Code() const { return static_cast<int>(code); }
+
+    std::string ToString() const { return std::string(StatusCodeToString(code)) + ": " + message; }
+};
+
+/**
+ * @brief Minimal expected-style result holding either a value or an Error
+ *
+ * Lets hot paths report failures without throwing; callers that prefer exceptions
+ * use value(), which throws std::runtime_error with the error message.
+ */
+template <typename T, typename E = Error>
+class Result {
+    static_assert(!std::is_same<T, E>::value, "Result value and error types must differ");
+
+public:
+    Result(const T& value) : storage_(std::in_place_index<0>, value) {}
+    Result(T&& value) : storage_(std::in_place_index<0>, std::move(value)) {}
+    Result(const E& error) : storage_(std::in_place_index<1>, error) {}
+    Result(E&& error) : storage_(std::in_place_index<1>, std::move(error)) {}
+
+    bool ok() const { return storage_.index() == 0; }
+    explicit operator bool() const { return ok(); }
+
+    const T& value() const& {
+        throwIfError();
+        return std::get<0>(storage_);
+    }
+    T& value() & {
+        throwIfError();
+        return std::get<0>(storage_);
+    }
+    T&& value() && {
+        throwIfError();
+        return std::get<0>(std::move(storage_));
+    }
+
+    template <typename U>
+    T value_or(U&& fallback) const& {
+        return ok() ? std::get<0>(storage_) : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    /**
+     * @brief Access the error; only valid when ok() is false
+     */
+    const E& error() const& { return std::get<1>(storage_); }
+    E&& error() && { return std::get<1>(std::move(storage_)); }
+
+private:
+    void throwIfError() const {
+        if (!ok()) {
+            throw std::runtime_error(errorMessage(std::get<1>(storage_)));
+        }
+    }
+
+    static std::string errorMessage(const Error& error) { return error.message; }
+    template <typename U>
+    static std::string errorMessage(const U&) {
+        return "Result holds an error";
+    }
+
+    std::variant<T, E> storage_;
+};
+
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "croupier/sdk/threading/wakeup_fd.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace croupier {
+namespace sdk {
+
+/**
+ * @brief Where the SDK runs background work
+ *
+ * Implement it to hand SDK tasks to an engine job system. Tasks may block on network I/O, so Post
+ * must not run them inline on the caller's thread.
+ */
+class Executor {
+public:
+    using Task = std::function<void()>;
+
+    virtual ~Executor() = default;
+
+    virtual void Post(Task task) = 0;
+};
+
+struct RuntimeConfig {
+    int worker_threads = 4;              // Pool size; ignored when executor is set
+    std::shared_ptr<Executor> executor;  // Run tasks on this instead of an owned pool
+};
+
+/**
+ * @brief Thread pool, timers and socket readiness shared by clients and invokers
+ *
+ * Owns worker_threads pool threads (none when an executor is injected) plus one reactor thread
+ * that fires timers and watches sockets; timer and watch callbacks are posted to the executor.
+ * Clients and invokers configured with a Runtime start no threads of their own, so the process
+ * thread count stays fixed however many clients, invokers and jobs exist.
+ */
+class Runtime : public Executor {
+public:
+    using SourceId = uint64_t;
+
+    explicit Runtime(const RuntimeConfig& config = RuntimeConfig());
+    ~Runtime() override;
+
+    Runtime(const Runtime&) = delete;
+    Runtime& operator=(const Runtime&) = delete;
+
+    void Post(Task task) override;
+
+    /**
+     * @brief Run task once after delay
+     */
+    SourceId ScheduleAfter(std::chrono::milliseconds delay, Task task);
+
+    /**
+     * @brief Run task every interval, the first time after one interval; runs never overlap
+     */
+    SourceId SchedulePeriodic(std::chrono::milliseconds interval, Task task);
+
+    /**
+     * @brief Run callback whenever fd is readable; it is not re-armed until the callback returns
+     */
+    SourceId WatchReadable(int fd, Task callback);
+
+    /**
+     * @brief Stop a timer or watch. Waits for a running callback to finish unless called from it,
+     *        so objects the callback captured may be destroyed afterwards.
+     */
+    void Cancel(SourceId id);
+
+    /**
+     * @brief Threads owned by the runtime (pool plus reactor)
+     */
+    size_t ThreadCount() const;
+
+    /**
+     * @brief Stop the reactor, run the queued tasks and join all threads; idempotent
+     */
+    void Shutdown();
+
+private:
+    struct Source {
+        SourceId id = 0;
+        Task task;
+        int fd = -1;                            // Watched descriptor, -1 for timers
+        std::chrono::milliseconds interval{0};  // Periodic timers only
+        std::chrono::steady_clock::time_point due{};
+        bool cancelled = false;
+        bool running = false;
+        std::thread::id runner;
+    };
+
+    void workerLoop();
+    void reactorLoop();
+    void fire(const std::shared_ptr<Source>& source);
+
+    RuntimeConfig config_;
+    std::vector<std::thread> workers_;
+    std::thread reactor_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;  // Signalled when a source callback finishes
+    std::deque<Task> queue_;
+    std::map<SourceId, std::shared_ptr<Source>> sources_;
+    SourceId next_source_id_ = 1;
+    bool stopping_ = false;
+    threading::WakeupFd reactor_wakeup_;
+};
+
+/**
+ * @brief Tracks tasks posted to an executor so their owner can wait for them before it goes away
+ */
+class TaskGroup {
+public:
+    void Post(Executor& executor, Executor::Task task);
+
+    /**
+     * @brief Block until every task posted through this group has finished
+     */
+    void Wait();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    size_t outstanding_ = 0;
+};
+
+}  // namespace sdk
+}  // namespace croupier
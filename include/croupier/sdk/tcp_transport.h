@@ -10,6 +10,7 @@
 #define CROUPIER_SDK_TCP_TRANSPORT_H
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -39,6 +40,7 @@ typedef int socket_t;
 #endif
 
 #include "protocol.h"
+#include "result.h"
 
 namespace croupier {
 namespace sdk {
@@ -49,6 +51,8 @@ namespace sdk {
  */
 class TCPTransport {
 public:
+    using ResponseHandler = std::function<void(Result<std::pair<uint32_t, std::vector<uint8_t>>>)>;
+
     /**
      * Initialize TCP transport.
      *
@@ -70,6 +74,16 @@ class TCPTransport {
     TCPTransport(TCPTransport&& other) noexcept;
     TCPTransport& operator=(TCPTransport&& other) noexcept;
 
+    /**
+     * Select polled mode; must be called before Connect.
+     *
+     * A polled transport starts no read thread: the thread calling TryCall
+     * reads frames from the socket itself until its response arrives, and
+     * ProcessIncoming() drains frames that arrive between calls. Used when
+     * the host's event loop drives the SDK.
+     */
+    void SetPolled(bool polled);
+
     /**
      * Connect to the TCP server (Agent).
      */
@@ -96,6 +110,64 @@ class TCPTransport {
     std::pair<uint32_t, std::vector<uint8_t>> Call(uint32_t msg_type,
                                                     const std::vector<uint8_t>& data);
 
+    /**
+     * Non-throwing variant of Call.
+     *
+     * @param msg_type Protocol message type (e.g., MSG_INVOKE_REQUEST)
+     * @param data Protobuf serialized request body
+     * @return (response_msg_type, response_data) on success, otherwise an Error with
+     *         UNAVAILABLE (not connected / send failed), DEADLINE_EXCEEDED (timeout) or INTERNAL
+     */
+    Result<std::pair<uint32_t, std::vector<uint8_t>>> TryCall(uint32_t msg_type,
+                                                              const std::vector<uint8_t>& data);
+
+    /**
+     * Send several requests in a single write and wait for all responses.
+     *
+     * @param requests (msg_type, body) pairs
+     * @return One result per request, in request order, with the same
+     *         errors as TryCall
+     */
+    std::vector<Result<std::pair<uint32_t, std::vector<uint8_t>>>> TryCallBatch(
+        const std::vector<std::pair<uint32_t, std::vector<uint8_t>>>& requests);
+
+    /**
+     * Send a request without waiting; on_response runs once with the reply,
+     * or with an error if the connection closes or no reply arrives within
+     * the transport timeout.
+     *
+     * The reply is routed by whichever thread reads the socket: the read
+     * thread, or on a polled transport ProcessIncoming() and concurrent
+     * TryCall callers. Overdue requests are failed by ProcessIncoming().
+     * on_response runs without transport locks held.
+     *
+     * @return Request id, or UNAVAILABLE if the request could not be sent
+     *         (on_response is not called then)
+     */
+    Result<uint32_t> CallAsync(uint32_t msg_type, const std::vector<uint8_t>& data, ResponseHandler on_response);
+
+    /**
+     * Number of requests still waiting for their response; a replaced
+     * transport is closed once this reaches zero. CallAsync requests are
+     * not counted.
+     */
+    size_t PendingCalls() const;
+
+    /**
+     * Socket descriptor, for registering a polled transport with an event loop.
+     */
+    socket_t Fd() const { return socket_; }
+
+    /**
+     * Read and route the frames already available on a polled transport
+     * without blocking; a partially received frame stays buffered until the
+     * rest arrives. Returns 0 at once if another thread is already reading,
+     * since that thread routes the frames.
+     *
+     * @return Number of frames read
+     */
+    int ProcessIncoming();
+
 private:
     struct ResponseLatch {
         std::mutex mutex;
@@ -103,6 +175,7 @@ class TCPTransport {
         std::vector<uint8_t> body;
         uint32_t msg_id = 0;
         bool ready = false;
+        bool aborted = false;
 
         bool Wait(int timeout_ms) {
             std::unique_lock<std::mutex> lock(mutex);
@@ -117,8 +190,39 @@ class TCPTransport {
             ready = true;
             cv.notify_one();
         }
+
+        bool Ready() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return ready;
+        }
+
+        void Abort() {
+            std::lock_guard<std::mutex> lock(mutex);
+            aborted = true;
+            ready = true;
+            cv.notify_one();
+        }
     };
 
+    struct PendingHandler {
+        ResponseHandler on_response;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    static void AppendFrame(std::vector<uint8_t>& out, uint32_t msg_type, uint32_t req_id,
+                            const std::vector<uint8_t>& data);
+    bool SendFrames(const std::vector<uint8_t>& frames);
+    Result<std::pair<uint32_t, std::vector<uint8_t>>> AwaitResponse(uint32_t req_id,
+                                                                    ResponseLatch& latch);
+    void ForgetPending(uint32_t req_id);
+    bool ReadFrame();
+    bool ReadAvailable();
+    int RouteBufferedFrames();
+    void RouteFrame(const uint8_t* payload, size_t size);
+    void ExpireHandlers();
+    bool WaitReadable(int timeout_ms) const;
+    bool PumpUntilReady(ResponseLatch& latch, int timeout_ms);
+
     void ReadLoop();
     int ReadFully(void* buf, size_t count);
     static void PutMsgId(uint8_t* buf, uint32_t msg_id);
@@ -130,9 +234,14 @@ class TCPTransport {
     socket_t socket_;
     std::atomic<bool> connected_;
     std::atomic<bool> closing_;
+    bool polled_ = false;
+    std::mutex read_mutex_;   // Serializes readers of a polled transport
+    std::mutex write_mutex_;  // Keeps frames from concurrent callers whole
     std::atomic<uint32_t> next_req_id_;
-    std::unordered_map<uint32_t, std::unique_ptr<ResponseLatch>> pending_responses_;
-    std::mutex pending_mutex_;
+    std::vector<uint8_t> read_buffer_;  // Bytes a polled transport received past the last whole frame
+    std::unordered_map<uint32_t, std::shared_ptr<ResponseLatch>> pending_responses_;
+    std::unordered_map<uint32_t, PendingHandler> pending_handlers_;
+    mutable std::mutex pending_mutex_;
     std::thread read_thread_;
 
     static constexpr size_t FRAME_HEADER_BYTES = 4;
@@ -0,0 +1,466 @@
+// Copyright 2025 Croupier Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "croupier/sdk/threading/mpsc_queue.h"
+#include "croupier/sdk/threading/unique_callback.h"
+#include "croupier/sdk/threading/wakeup_fd.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <climits>
+
+namespace croupier {
+namespace sdk {
+namespace threading {
+
+/**
+ * @brief Thread-affine callback queue: any thread enqueues, the owner thread runs.
+ *
+ * Create one per shard or world thread; MainThreadDispatcher is the process-wide instance for
+ * the game's main thread. The owner calls Initialize() once and then ProcessQueue() from its
+ * loop, or WaitAndProcess() if it has no fixed tick.
+ *
+ * Enqueue is lock-free: callbacks go into an intrusive MPSC queue, and small callables are
+ * stored inline in the queue node rather than in a separate std::function allocation.
+ * ProcessQueue claims everything queued with one atomic exchange and runs the batch without
+ * taking a lock per callback.
+ *
+ * Callbacks go into one of two lanes. CRITICAL (the default, e.g. invoke completions) always
+ * runs before BACKGROUND (metrics, log forwarding), which only runs once the critical lane is
+ * empty. Use ProcessQueueFor to bound a frame by time rather than by count, and GetStats to see
+ * how long callbacks wait and how deep the queue gets when tuning that budget.
+ *
+ * Loops without a fixed tick can sleep instead of polling: call WaitAndProcess(timeout_ms), or
+ * register GetEventFd() with epoll/libuv and call ProcessQueue when it becomes readable.
+ */
+class Dispatcher {
+public:
+    using Callback = UniqueCallback;
+    using Clock = std::chrono::steady_clock;
+
+    enum class Priority { CRITICAL = 0, BACKGROUND = 1 };
+
+    struct LaneStats {
+        uint64_t executed = 0;                       // Callbacks run from the queue
+        std::chrono::microseconds total_latency{0};  // Sum of enqueue-to-execute delays
+        std::chrono::microseconds max_latency{0};    // Longest enqueue-to-execute delay
+
+        std::chrono::microseconds AverageLatency() const {
+            return executed == 0 ? std::chrono::microseconds(0)
+                                 : std::chrono::microseconds(total_latency.count() / static_cast<int64_t>(executed));
+        }
+    };
+
+    struct Stats {
+        LaneStats critical;
+        LaneStats background;
+        size_t pending_high_water = 0;  // Most callbacks queued at once, both lanes together
+    };
+
+    Dispatcher() = default;
+    ~Dispatcher() { Clear(); }
+
+    Dispatcher(const Dispatcher&) = delete;
+    Dispatcher& operator=(const Dispatcher&) = delete;
+    Dispatcher(Dispatcher&&) = delete;
+    Dispatcher& operator=(Dispatcher&&) = delete;
+
+    /**
+     * @brief Bind the dispatcher to the calling thread, which then runs its callbacks.
+     */
+    void Initialize() {
+        owner_thread_id_ = std::this_thread::get_id();
+        initialized_.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Check if the dispatcher has been initialized
+     * @return true if initialized
+     */
+    bool IsInitialized() const {
+        return initialized_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Enqueue a callback to be executed on the owner thread.
+     * If called from the owner thread and initialized, executes immediately.
+     * Safe to call from any thread without blocking.
+     * @param callback The callback to execute; may be move-only
+     * @param priority Lane to queue the callback in
+     */
+    void Enqueue(Callback callback, Priority priority = Priority::CRITICAL) {
+        if (!callback) return;
+
+        // If already on the owner thread and initialized, execute immediately
+        if (IsOwnerThread()) {
+            try {
+                callback();
+            } catch (...) {
+                // Log but don't propagate
+            }
+            return;
+        }
+
+        push(lanes_[static_cast<int>(priority)].queue, std::move(callback));
+    }
+
+    /**
+     * @brief Enqueue a callback for the next ProcessQueue call rather than the current one.
+     * Never runs inline, even on the owner thread, so a callback can spread work over frames
+     * by deferring the rest of it.
+     */
+    void EnqueueNextFrame(Callback callback, Priority priority = Priority::CRITICAL) {
+        if (!callback) return;
+        push(lanes_[static_cast<int>(priority)].next_frame, std::move(callback));
+    }
+
+    /**
+     * @brief Enqueue a callback with data to be executed on the owner thread.
+     * @tparam T Type of the data
+     * @param callback The callback to execute
+     * @param data The data to pass to the callback
+     */
+    template<typename T>
+    void Enqueue(std::function<void(T)> callback, T data) {
+        if (!callback) return;
+        Enqueue([callback = std::move(callback), data = std::move(data)]() {
+            callback(data);
+        });
+    }
+
+    /**
+     * @brief Process queued callbacks on the owner thread.
+     * Call this from your main loop.
+     * @return Number of callbacks processed
+     */
+    int ProcessQueue() {
+        return ProcessQueue(max_process_per_frame_.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Process queued callbacks, up to a maximum count.
+     * @param max_count Maximum number of callbacks to process
+     * @return Number of callbacks processed
+     */
+    int ProcessQueue(int max_count) {
+        return drain(max_count, Clock::time_point::max());
+    }
+
+    /**
+     * @brief Process queued callbacks until the time budget is used up.
+     * The clock is checked between callbacks, so a single slow callback can overrun the budget;
+     * at least one callback runs per call so the queue always makes progress.
+     * @param budget Time to spend, e.g. what is left of the frame
+     * @return Number of callbacks processed
+     */
+    int ProcessQueueFor(std::chrono::microseconds budget) {
+        return drain(INT_MAX, Clock::now() + budget);
+    }
+
+    /**
+     * @brief Descriptor that is readable while callbacks are pending; -1 if the platform has none.
+     * The first call enables wakeup notifications. Register it for readability and call
+     * ProcessQueue (or ProcessQueueFor) when it fires; draining resets it.
+     */
+    int GetEventFd() {
+        return ensureWakeup()->Fd();
+    }
+
+    /**
+     * @brief Sleep until a callback is enqueued or timeout_ms elapses, then process the queue.
+     * For main loops without a fixed tick. A negative timeout waits indefinitely.
+     * @return Number of callbacks processed
+     */
+    int WaitAndProcess(int timeout_ms) {
+        WakeupFd* wakeup = ensureWakeup();
+        if (pending_.load() == 0) {
+            wakeup->Wait(timeout_ms);
+        }
+        return ProcessQueue();
+    }
+
+    /**
+     * @brief Get the number of pending callbacks in the queue.
+     * @return Number of pending callbacks
+     */
+    size_t GetPendingCount() const {
+        return pending_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Latency and queue depth statistics since startup or the last ResetStats().
+     */
+    Stats GetStats() const {
+        Stats stats;
+        stats.critical = lanes_[static_cast<int>(Priority::CRITICAL)].Snapshot();
+        stats.background = lanes_[static_cast<int>(Priority::BACKGROUND)].Snapshot();
+        stats.pending_high_water = pending_high_water_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /**
+     * @brief Clear statistics; the high-water mark restarts from the current queue depth.
+     */
+    void ResetStats() {
+        for (auto& lane : lanes_) {
+            lane.executed.store(0, std::memory_order_relaxed);
+            lane.total_latency_us.store(0, std::memory_order_relaxed);
+            lane.max_latency_us.store(0, std::memory_order_relaxed);
+        }
+        pending_high_water_.store(pending_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of ProcessQueue (or ProcessQueueFor) calls started so far.
+     * Callbacks run by the same call see the same value, so a callback that re-enqueues itself
+     * can keep a budget per frame rather than per run.
+     */
+    uint64_t GetFrameNumber() const {
+        return frames_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Check if the current thread is the one the dispatcher was initialized on.
+     * @return true if on the owner thread
+     */
+    bool IsOwnerThread() const {
+        return IsInitialized() && std::this_thread::get_id() == owner_thread_id_;
+    }
+
+    /**
+     * @brief Set the maximum number of callbacks to process per frame.
+     * @param max Maximum callbacks per frame. Use INT_MAX for unlimited.
+     */
+    void SetMaxProcessPerFrame(int max) {
+        max_process_per_frame_.store(max > 0 ? max : INT_MAX, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Clear all pending callbacks from the queue.
+     */
+    void Clear() {
+        size_t count = 0;
+        for (auto& lane : lanes_) {
+            Task* tasks = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(drain_mutex_);
+                tasks = lane.batch;
+                lane.batch = nullptr;
+            }
+            count += DeleteTasks(tasks);
+            count += DeleteTasks(lane.queue.TakeAll());
+            count += DeleteTasks(lane.next_frame.TakeAll());
+        }
+        pending_.fetch_sub(count);
+        rearmWakeup();
+    }
+
+    /**
+     * @brief Reset the dispatcher state. Primarily for testing.
+     */
+    void Reset() {
+        Clear();
+        ResetStats();
+        initialized_.store(false, std::memory_order_release);
+        owner_thread_id_ = std::thread::id();
+    }
+
+private:
+    struct Task {
+        Callback callback;
+        Clock::time_point enqueued_at;
+        Task* next;
+    };
+
+    struct Lane {
+        MpscQueue<Task> queue;
+        MpscQueue<Task> next_frame;  // Moved into queue when the next drain starts
+        Task* batch = nullptr;  // Claimed from queue but not yet run, oldest first; guarded by drain_mutex_
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> total_latency_us{0};
+        std::atomic<uint64_t> max_latency_us{0};
+
+        void Record(Clock::duration latency) {
+            const auto us =
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+            executed.fetch_add(1, std::memory_order_relaxed);
+            total_latency_us.fetch_add(us, std::memory_order_relaxed);
+            uint64_t max = max_latency_us.load(std::memory_order_relaxed);
+            while (us > max && !max_latency_us.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+            }
+        }
+
+        LaneStats Snapshot() const {
+            LaneStats stats;
+            stats.executed = executed.load(std::memory_order_relaxed);
+            stats.total_latency =
+                std::chrono::microseconds(static_cast<int64_t>(total_latency_us.load(std::memory_order_relaxed)));
+            stats.max_latency =
+                std::chrono::microseconds(static_cast<int64_t>(max_latency_us.load(std::memory_order_relaxed)));
+            return stats;
+        }
+    };
+
+    void push(MpscQueue<Task>& queue, Callback callback) {
+        const size_t depth = pending_.fetch_add(1) + 1;
+        size_t high_water = pending_high_water_.load(std::memory_order_relaxed);
+        while (depth > high_water &&
+               !pending_high_water_.compare_exchange_weak(high_water, depth, std::memory_order_relaxed)) {
+        }
+        queue.Push(new Task{std::move(callback), Clock::now(), nullptr});
+
+        // Only the empty to non-empty transition wakes the consumer; it re-arms itself if work is left over
+        if (depth == 1) {
+            if (WakeupFd* wakeup = wakeup_.load()) {
+                wakeup->Notify();
+            }
+        }
+    }
+
+    int drain(int max_count, Clock::time_point deadline) {
+        int processed = 0;
+        frames_.fetch_add(1, std::memory_order_relaxed);
+
+        for (auto& lane : lanes_) {
+            for (Task* task = lane.next_frame.TakeAll(); task;) {
+                lane.queue.Push(std::exchange(task, task->next));
+            }
+        }
+
+        while (processed < max_count) {
+            // Cut the next run off the highest-priority lane with work, refilling its batch from the queue
+            Lane* lane = nullptr;
+            Task* run = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(drain_mutex_);
+                for (auto& candidate : lanes_) {
+                    if (!candidate.batch) {
+                        candidate.batch = candidate.queue.TakeAll();
+                    }
+                    if (candidate.batch) {
+                        lane = &candidate;
+                        break;
+                    }
+                }
+                if (!lane) break;
+                run = lane->batch;
+                Task* last = run;
+                for (int count = 1; last->next && processed + count < max_count; count++) {
+                    last = last->next;
+                }
+                lane->batch = last->next;
+                last->next = nullptr;
+            }
+
+            const int before = processed;
+            auto now = Clock::now();
+            while (run) {
+                if (now >= deadline && processed > 0) {
+                    // Out of time: put the rest back in front of the lane's batch
+                    Task* last = run;
+                    while (last->next) {
+                        last = last->next;
+                    }
+                    std::lock_guard<std::mutex> lock(drain_mutex_);
+                    last->next = lane->batch;
+                    lane->batch = run;
+                    break;
+                }
+
+                Task* next = run->next;
+                lane->Record(now - run->enqueued_at);
+                try {
+                    if (run->callback) {
+                        run->callback();
+                    }
+                } catch (...) {
+                    // Log but don't interrupt processing
+                }
+                delete run;
+                run = next;
+                processed++;
+                now = Clock::now();
+            }
+            pending_.fetch_sub(static_cast<size_t>(processed - before));
+            if (run) break;
+        }
+
+        rearmWakeup();
+        return processed;
+    }
+
+    WakeupFd* ensureWakeup() {
+        WakeupFd* wakeup = wakeup_.load();
+        if (wakeup) {
+            return wakeup;
+        }
+        std::lock_guard<std::mutex> lock(wakeup_mutex_);
+        if (!wakeup_owner_) {
+            wakeup_owner_ = std::make_unique<WakeupFd>();
+            wakeup_.store(wakeup_owner_.get());
+            // Enqueues that ran before the store saw no wakeup to notify
+            if (pending_.load() > 0) {
+                wakeup_owner_->Notify();
+            }
+        }
+        return wakeup_owner_.get();
+    }
+
+    // Reset the wakeup after draining, leaving it set if callbacks are still queued
+    void rearmWakeup() {
+        WakeupFd* wakeup = wakeup_.load(std::memory_order_acquire);
+        if (!wakeup) {
+            return;
+        }
+        wakeup->Clear();
+        if (pending_.load() > 0) {
+            wakeup->Notify();
+        }
+    }
+
+    static size_t DeleteTasks(Task* task) {
+        size_t count = 0;
+        while (task) {
+            Task* next = task->next;
+            delete task;
+            task = next;
+            count++;
+        }
+        return count;
+    }
+
+    Lane lanes_[2];           // Indexed by Priority, drained in that order
+    std::mutex drain_mutex_;  // Guards each lane's batch; never held while callbacks execute
+    std::atomic<size_t> pending_{0};  // Sequentially consistent so enqueue and drain never both miss a wakeup
+    std::atomic<size_t> pending_high_water_{0};
+    std::atomic<uint64_t> frames_{0};
+    std::mutex wakeup_mutex_;
+    std::unique_ptr<WakeupFd> wakeup_owner_;  // Created by the first GetEventFd or WaitAndProcess
+    std::atomic<WakeupFd*> wakeup_{nullptr};
+    std::thread::id owner_thread_id_;
+    std::atomic<bool> initialized_{false};
+    std::atomic<int> max_process_per_frame_{INT_MAX};
+};
+
+}  // namespace threading
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,73 @@
+// Copyright 2025 Croupier Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+
+namespace croupier {
+namespace sdk {
+namespace threading {
+
+/**
+ * @brief Intrusive lock-free multi-producer, single-consumer queue.
+ *
+ * Node must have a `Node* next` member; the queue never allocates. Producers push with one
+ * CAS. The consumer claims everything pushed so far with a single atomic exchange and gets it
+ * back oldest first, so draining a burst costs one atomic operation rather than one per item.
+ * Since the consumer never pops single nodes, there is no ABA hazard.
+ */
+template <typename Node>
+class MpscQueue {
+public:
+    MpscQueue() = default;
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Push from any thread
+     * @return true if the queue was empty before this push
+     */
+    bool Push(Node* node) noexcept {
+        Node* head = head_.load(std::memory_order_relaxed);
+        do {
+            node->next = head;
+        } while (!head_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+        return head == nullptr;
+    }
+
+    /**
+     * @brief Claim every queued node, linked through next in push order; nullptr if empty
+     */
+    Node* TakeAll() noexcept {
+        Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+        Node* ordered = nullptr;
+        while (node) {
+            Node* next = node->next;
+            node->next = ordered;
+            ordered = node;
+            node = next;
+        }
+        return ordered;
+    }
+
+    bool Empty() const noexcept { return head_.load(std::memory_order_acquire) == nullptr; }
+
+private:
+    std::atomic<Node*> head_{nullptr};  // Newest first
+};
+
+}  // namespace threading
+}  // namespace sdk
+}  // namespace croupier
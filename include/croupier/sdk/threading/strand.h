@@ -0,0 +1,187 @@
+// Copyright 2025 Croupier Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "croupier/sdk/runtime.h"
+#include "croupier/sdk/threading/mpsc_queue.h"
+#include "croupier/sdk/threading/unique_callback.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace croupier {
+namespace sdk {
+namespace threading {
+
+/**
+ * @brief Serial executor: callbacks posted to a strand run one at a time, in post order.
+ *
+ * The strand has no thread of its own. While it has work, one drain job runs on the underlying
+ * executor (usually a Runtime), so different strands run in parallel on the pool while each
+ * strand's callbacks never overlap. State touched only from one strand needs no lock.
+ *
+ * Posting is lock-free. A drain job runs at most kMaxPerDrain callbacks before yielding its
+ * worker and posting itself again, so a busy strand cannot starve the others. The executor
+ * must outlive every callback posted to the strand; a Runtime does, since it finishes queued
+ * tasks when it shuts down.
+ */
+class Strand {
+public:
+    static constexpr size_t kMaxPerDrain = 64;
+
+    explicit Strand(Executor& executor) : state_(std::make_shared<State>(executor)) {}
+
+    Strand(const Strand&) = delete;
+    Strand& operator=(const Strand&) = delete;
+
+    /**
+     * @brief Queue a callback; safe from any thread, including from a callback on this strand.
+     * Callbacks still queued when the strand is destroyed run anyway: the drain job keeps them alive.
+     */
+    void Post(UniqueCallback callback) {
+        if (!callback) return;
+        state_->queue.Push(new Task{std::move(callback), nullptr});
+        if (state_->pending.fetch_add(1) == 0) {
+            Schedule(state_);
+        }
+    }
+
+    /**
+     * @brief Check if the calling thread is running a callback of this strand.
+     */
+    bool RunningInThisThread() const {
+        return state_->running_thread.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+
+    size_t GetPendingCount() const {
+        return state_->pending.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Task {
+        UniqueCallback callback;
+        Task* next;
+    };
+
+    struct State {
+        explicit State(Executor& executor) : executor(executor) {}
+
+        Executor& executor;
+        MpscQueue<Task> queue;
+        Task* batch = nullptr;           // Taken from queue, not yet run; only touched by the drain job
+        std::atomic<size_t> pending{0};  // Posted and not yet run; the 0 to 1 transition schedules a drain
+        std::atomic<std::thread::id> running_thread{std::thread::id()};
+
+        ~State() {
+            while (batch) {
+                delete std::exchange(batch, batch->next);
+            }
+            for (Task* task = queue.TakeAll(); task;) {
+                delete std::exchange(task, task->next);
+            }
+        }
+    };
+
+    static void Schedule(const std::shared_ptr<State>& state) {
+        state->executor.Post([state]() { Drain(state); });
+    }
+
+    static void Drain(const std::shared_ptr<State>& state) {
+        state->running_thread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        size_t ran = 0;
+        while (ran < kMaxPerDrain) {
+            if (!state->batch) {
+                state->batch = state->queue.TakeAll();
+                if (!state->batch) {
+                    // A producer counted its task but has not linked it yet
+                    std::this_thread::yield();
+                    continue;
+                }
+            }
+            Task* task = std::exchange(state->batch, state->batch->next);
+            try {
+                task->callback();
+            } catch (...) {
+                // Log but don't interrupt processing
+            }
+            delete task;
+            ran++;
+            if (state->pending.fetch_sub(1) == 1) {
+                state->running_thread.store(std::thread::id(), std::memory_order_relaxed);
+                return;
+            }
+        }
+        // More work is queued: requeue behind other strands instead of holding this worker
+        state->running_thread.store(std::thread::id(), std::memory_order_relaxed);
+        Schedule(state);
+    }
+
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * @brief Fixed set of strands selected by key, e.g. player or guild ID.
+ *
+ * Work for the same key runs in order on the same strand; different keys usually land on
+ * different strands and run in parallel. Keys are hashed onto strand_count strands rather
+ * than given one each, so there is no per-key map or lock, and memory stays bounded. Two
+ * keys that share a strand are serialized with each other; raise strand_count if that costs
+ * throughput.
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class KeyedStrands {
+public:
+    /**
+     * @throws std::runtime_error if strand_count is 0
+     */
+    explicit KeyedStrands(Executor& executor, size_t strand_count = 64) {
+        if (strand_count == 0) {
+            throw std::runtime_error("KeyedStrands requires at least one strand");
+        }
+        strands_.reserve(strand_count);
+        for (size_t i = 0; i < strand_count; ++i) {
+            strands_.push_back(std::make_unique<Strand>(executor));
+        }
+    }
+
+    /**
+     * @brief Queue a callback behind earlier callbacks for the same key.
+     */
+    void Post(const Key& key, UniqueCallback callback) {
+        StrandFor(key).Post(std::move(callback));
+    }
+
+    Strand& StrandFor(const Key& key) {
+        return *strands_[hash_(key) % strands_.size()];
+    }
+
+    size_t StrandCount() const {
+        return strands_.size();
+    }
+
+private:
+    Hash hash_;
+    std::vector<std::unique_ptr<Strand>> strands_;
+};
+
+}  // namespace threading
+}  // namespace sdk
+}  // namespace croupier
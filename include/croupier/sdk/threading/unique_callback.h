@@ -0,0 +1,141 @@
+// Copyright 2025 Croupier Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace croupier {
+namespace sdk {
+namespace threading {
+
+/**
+ * @brief Move-only void() callable with small-buffer storage.
+ *
+ * Callables up to kInlineSize bytes (a lambda capturing a few pointers, a shared_ptr and a
+ * std::string, say) are stored inline, so wrapping them does not allocate. Larger ones fall
+ * back to the heap. Unlike std::function, move-only captures (unique_ptr, promise) are allowed.
+ */
+class UniqueCallback {
+public:
+    static constexpr size_t kInlineSize = 6 * sizeof(void*);
+
+    UniqueCallback() noexcept = default;
+    UniqueCallback(std::nullptr_t) noexcept {}  // NOLINT(google-explicit-constructor)
+
+    template <typename F,
+              typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<Fn, UniqueCallback> && std::is_invocable_v<Fn&>>>
+    UniqueCallback(F&& callable) {  // NOLINT(google-explicit-constructor)
+        if (IsNull(callable)) {
+            return;
+        }
+        if constexpr (kFitsInline<Fn>) {
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(callable));
+            ops_ = &kInlineOps<Fn>;
+        } else {
+            ::new (static_cast<void*>(storage_)) Fn*(new Fn(std::forward<F>(callable)));
+            ops_ = &kHeapOps<Fn>;
+        }
+    }
+
+    UniqueCallback(UniqueCallback&& other) noexcept { moveFrom(other); }
+
+    UniqueCallback& operator=(UniqueCallback&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    UniqueCallback& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    UniqueCallback(const UniqueCallback&) = delete;
+    UniqueCallback& operator=(const UniqueCallback&) = delete;
+
+    ~UniqueCallback() { reset(); }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    void operator()() { ops_->invoke(storage_); }
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*relocate)(void* from, void* to) noexcept;  // Move into to and destroy from
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename Fn>
+    static constexpr bool kFitsInline = sizeof(Fn) <= kInlineSize && alignof(Fn) <= alignof(std::max_align_t) &&
+                                        std::is_nothrow_move_constructible_v<Fn>;
+
+    template <typename Fn>
+    static constexpr Ops kInlineOps = {
+        [](void* storage) { (*static_cast<Fn*>(storage))(); },
+        [](void* from, void* to) noexcept {
+            ::new (to) Fn(std::move(*static_cast<Fn*>(from)));
+            static_cast<Fn*>(from)->~Fn();
+        },
+        [](void* storage) noexcept { static_cast<Fn*>(storage)->~Fn(); },
+    };
+
+    template <typename Fn>
+    static constexpr Ops kHeapOps = {
+        [](void* storage) { (**static_cast<Fn**>(storage))(); },
+        [](void* from, void* to) noexcept { ::new (to) Fn*(*static_cast<Fn**>(from)); },
+        [](void* storage) noexcept { delete *static_cast<Fn**>(storage); },
+    };
+
+    // Empty std::function objects and null function pointers produce an empty callback
+    template <typename Fn>
+    static bool IsNull(const Fn& callable) {
+        if constexpr (std::is_pointer_v<Fn> || std::is_member_pointer_v<Fn>) {
+            return callable == nullptr;
+        } else if constexpr (std::is_same_v<Fn, std::function<void()>>) {
+            return !callable;
+        } else {
+            return false;
+        }
+    }
+
+    void moveFrom(UniqueCallback& other) noexcept {
+        if (other.ops_) {
+            other.ops_->relocate(other.storage_, storage_);
+            ops_ = std::exchange(other.ops_, nullptr);
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+    const Ops* ops_ = nullptr;
+};
+
+}  // namespace threading
+}  // namespace sdk
+}  // namespace croupier
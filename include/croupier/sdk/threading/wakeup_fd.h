@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+
+namespace croupier {
+namespace sdk {
+namespace threading {
+
+/**
+ * @brief Level-triggered readiness signal that an external event loop can poll
+ *
+ * Backed by an eventfd on Linux and a non-blocking pipe on other POSIX systems: Fd() becomes
+ * readable after Notify() and stays readable until Clear(), and repeated notifications coalesce
+ * into one. Where neither is available Fd() returns -1 and only Wait() can observe the signal.
+ */
+class WakeupFd {
+public:
+    WakeupFd();
+    ~WakeupFd();
+
+    WakeupFd(const WakeupFd&) = delete;
+    WakeupFd& operator=(const WakeupFd&) = delete;
+
+    /**
+     * @brief Descriptor to register for readability with epoll, libuv and the like; -1 if unsupported
+     */
+    int Fd() const { return read_fd_; }
+
+    /**
+     * @brief Mark work as pending and wake any poller; safe from any thread
+     */
+    void Notify();
+
+    /**
+     * @brief Consume the pending notification so Fd() stops being readable
+     */
+    void Clear();
+
+    /**
+     * @brief Block until notified or timeout_ms elapses (negative waits indefinitely); does not Clear
+     * @return true if a notification is pending
+     */
+    bool Wait(int timeout_ms);
+
+    bool Pending() const;
+
+private:
+    int read_fd_ = -1;
+    int write_fd_ = -1;  // Same as read_fd_ for an eventfd
+    bool pending_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+}  // namespace threading
+}  // namespace sdk
+}  // namespace croupier
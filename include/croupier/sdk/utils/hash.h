@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace croupier {
+namespace sdk {
+namespace utils {
+
+constexpr uint64_t kFnv1aOffset = 14695981039346656037ULL;
+constexpr uint64_t kFnv1aPrime = 1099511628211ULL;
+
+/**
+ * @brief 64-bit FNV-1a hash, stable across runs and platforms
+ *
+ * Cheap for the short keys the SDK hashes (function IDs, trace IDs, JSON keys).
+ * Pass a previous result as seed to hash several fields in sequence.
+ */
+inline uint64_t Fnv1a(const char* data, size_t size, uint64_t seed = kFnv1aOffset) {
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * kFnv1aPrime;
+    }
+    return hash;
+}
+
+inline uint64_t Fnv1a(const std::string& data, uint64_t seed = kFnv1aOffset) {
+    return Fnv1a(data.data(), data.size(), seed);
+}
+
+/**
+ * @brief Mix the 8 bytes of value into hash, least significant byte first
+ */
+inline uint64_t Fnv1a(uint64_t value, uint64_t seed) {
+    uint64_t hash = seed;
+    for (int i = 0; i < 8; ++i) {
+        hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * kFnv1aPrime;
+    }
+    return hash;
+}
+
+}  // namespace utils
+}  // namespace sdk
+}  // namespace croupier
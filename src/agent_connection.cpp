@@ -0,0 +1,210 @@
+#include "croupier/sdk/agent_connection.h"
+
+#include "croupier/sdk/protocol_messages.h"
+#include "croupier/sdk/v1/provider.pb.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace croupier {
+namespace sdk {
+
+namespace {
+
+constexpr int kDefaultAgentPort = 19090;
+
+// Split "host:port" or "tcp://host:port" for TCPTransport
+void ParseAgentAddress(const std::string& address, std::string* host, int* port) {
+    std::string rest = address;
+    const auto scheme = rest.find("://");
+    if (scheme != std::string::npos) {
+        rest = rest.substr(scheme + 3);
+    }
+
+    *host = rest.empty() ? "127.0.0.1" : rest;
+    *port = kDefaultAgentPort;
+    const auto colon = rest.rfind(':');
+    if (colon == std::string::npos) {
+        return;
+    }
+    *host = rest.substr(0, colon);
+    try {
+        *port = std::stoi(rest.substr(colon + 1));
+    } catch (const std::exception&) {
+        throw std::runtime_error("invalid agent address: " + address);
+    }
+}
+
+}  // namespace
+
+std::shared_ptr<TransportWatch> TransportWatch::Start(const std::shared_ptr<Runtime>& runtime,
+                                                      TCPTransport& transport) {
+    auto watch = std::make_shared<TransportWatch>();
+    watch->runtime_ = runtime;
+    std::lock_guard<std::mutex> lock(watch->mutex_);
+    watch->id_ = runtime->WatchReadable(static_cast<int>(transport.Fd()), [watch, &transport]() {
+        transport.ProcessIncoming();
+        if (!transport.IsConnected()) {
+            watch->Stop();
+        }
+    });
+    return watch;
+}
+
+void TransportWatch::Stop() {
+    Runtime::SourceId id = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = std::exchange(id_, 0);
+    }
+    auto runtime = runtime_.lock();
+    if (id != 0 && runtime) {
+        runtime->Cancel(id);
+    }
+}
+
+AgentConnection::AgentConnection(const AgentConnectionConfig& config) : config_(config) {
+    if (!config_.runtime) {
+        throw std::runtime_error("AgentConnection requires a runtime");
+    }
+    ParseAgentAddress(config_.agent_addr, &host_, &port_);
+    heartbeat_timer_ = config_.runtime->SchedulePeriodic(std::chrono::seconds(std::max(1, config_.heartbeat_interval)),
+                                                         [this]() { SendHeartbeats(); });
+}
+
+AgentConnection::~AgentConnection() {
+    Close();
+}
+
+std::shared_ptr<TCPTransport> AgentConnection::Acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (transport_ && transport_->IsConnected()) {
+        return transport_;
+    }
+
+    if (watch_) {
+        watch_->Stop();
+        watch_.reset();
+    }
+    if (transport_) {
+        transport_->Close();
+        transport_.reset();
+    }
+
+    auto transport = std::make_shared<TCPTransport>(host_, port_, config_.timeout_seconds * 1000);
+    transport->SetPolled(true);
+    transport->Connect();
+    watch_ = TransportWatch::Start(config_.runtime, *transport);
+    transport_ = std::move(transport);
+    return transport_;
+}
+
+AgentConnection::TenantId AgentConnection::AddTenant(const std::string& service_id, LostHandler on_lost) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const TenantId id = next_tenant_id_++;
+    tenants_[id] = Tenant{service_id, std::string(), std::move(on_lost)};
+    return id;
+}
+
+void AgentConnection::SetSession(TenantId tenant, const std::string& session_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tenants_.find(tenant);
+    if (it != tenants_.end()) {
+        it->second.session_id = session_id;
+    }
+}
+
+void AgentConnection::RemoveTenant(TenantId tenant) {
+    std::lock_guard<std::mutex> delivery(delivery_mutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    tenants_.erase(tenant);
+}
+
+size_t AgentConnection::TenantCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tenants_.size();
+}
+
+size_t AgentConnection::SendHeartbeats() {
+    std::shared_ptr<TCPTransport> transport;
+    std::vector<TenantId> sent_for;
+    std::vector<std::string> sent_sessions;
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> requests;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        transport = transport_;
+        for (const auto& [id, tenant] : tenants_) {
+            if (tenant.session_id.empty()) {
+                continue;
+            }
+            croupier::sdk::v1::HeartbeatRequest request;
+            request.set_service_id(tenant.service_id);
+            request.set_session_id(tenant.session_id);
+            requests.emplace_back(protocol::MSG_HEARTBEAT_LOCAL_REQUEST, protocol::EncodeBody(request));
+            sent_for.push_back(id);
+            sent_sessions.push_back(tenant.session_id);
+        }
+    }
+    if (requests.empty()) {
+        return 0;
+    }
+
+    std::vector<Result<std::pair<uint32_t, std::vector<uint8_t>>>> results;
+    if (transport && transport->IsConnected()) {
+        results = transport->TryCallBatch(requests);
+    } else {
+        results.assign(requests.size(), Error(StatusCode::UNAVAILABLE, "heartbeat transport is not connected"));
+    }
+
+    size_t acknowledged = 0;
+    std::vector<std::pair<LostHandler, std::string>> lost;
+    std::lock_guard<std::mutex> delivery(delivery_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (results[i].ok()) {
+                acknowledged++;
+                continue;
+            }
+            // A tenant that re-registered meanwhile has a new session and stays alive
+            auto it = tenants_.find(sent_for[i]);
+            if (it == tenants_.end() || it->second.session_id != sent_sessions[i]) {
+                continue;
+            }
+            it->second.session_id.clear();
+            lost.emplace_back(it->second.on_lost, results[i].error().message);
+        }
+    }
+    for (const auto& [on_lost, error] : lost) {
+        if (on_lost) {
+            on_lost(error);
+        }
+    }
+    return acknowledged;
+}
+
+void AgentConnection::Close() {
+    Runtime::SourceId timer = 0;
+    std::shared_ptr<TransportWatch> watch;
+    std::shared_ptr<TCPTransport> transport;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        timer = std::exchange(heartbeat_timer_, 0);
+        watch = std::move(watch_);
+        transport = std::move(transport_);
+    }
+    if (timer != 0) {
+        config_.runtime->Cancel(timer);
+    }
+    if (watch) {
+        watch->Stop();
+    }
+    if (transport) {
+        transport->Close();
+    }
+}
+
+}  // namespace sdk
+}  // namespace croupier
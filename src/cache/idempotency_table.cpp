@@ -0,0 +1,141 @@
+#include "croupier/sdk/cache/idempotency_table.h"
+
+#include <algorithm>
+
+namespace croupier {
+namespace sdk {
+namespace cache {
+
+IdempotencyTable::IdempotencyTable(const IdempotencyConfig& config) : config_(config) {
+    if (!config_.enabled || config_.max_entries == 0 || config_.ttl_ms <= 0) {
+        return;
+    }
+    const size_t shard_count = static_cast<size_t>(std::max(1, config_.shards));
+    per_shard_capacity_ = std::max<size_t>(1, (config_.max_entries + shard_count - 1) / shard_count);
+    shards_.reserve(shard_count);
+    for (size_t i = 0; i < shard_count; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+std::string IdempotencyTable::MakeKey(const std::string& function_id, const std::string& idempotency_key) {
+    std::string key;
+    key.reserve(function_id.size() + idempotency_key.size() + 1);
+    key.append(function_id).push_back('\x1f');
+    key.append(idempotency_key);
+    return key;
+}
+
+std::string IdempotencyTable::Execute(const std::string& key, const std::function<std::string()>& fn,
+                                      bool* deduplicated, Clock::time_point now) {
+    if (deduplicated) {
+        *deduplicated = false;
+    }
+    if (shards_.empty() || key.empty()) {
+        return fn();
+    }
+
+    Shard& shard = shardFor(key);
+    std::promise<std::string> promise;
+    uint64_t sequence = 0;
+    {
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        expireLocked(shard, now);
+
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end()) {
+            std::shared_future<std::string> pending = it->second.result;
+            lock.unlock();
+            const bool ready = pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            (ready ? replays_ : joins_)++;
+            if (deduplicated) {
+                *deduplicated = true;
+            }
+            return pending.get();
+        }
+
+        while (shard.entries.size() >= per_shard_capacity_) {
+            evictOldestLocked(shard);
+        }
+        sequence = ++shard.next_sequence;
+        shard.entries.emplace(key, Entry{promise.get_future().share(), now + std::chrono::milliseconds(config_.ttl_ms),
+                                         sequence});
+        shard.order.emplace_back(key, sequence);
+    }
+
+    executions_++;
+    std::string result;
+    try {
+        result = fn();
+    } catch (...) {
+        forget(shard, key, sequence);
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+    if (result.size() > config_.max_response_bytes) {
+        forget(shard, key, sequence);
+    }
+    promise.set_value(result);
+    return result;
+}
+
+size_t IdempotencyTable::Size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total += shard->entries.size();
+    }
+    return total;
+}
+
+IdempotencyTable::Stats IdempotencyTable::GetStats() const {
+    Stats stats;
+    stats.executions = executions_.load();
+    stats.replays = replays_.load();
+    stats.joins = joins_.load();
+    stats.evictions = evictions_.load();
+    return stats;
+}
+
+IdempotencyTable::Shard& IdempotencyTable::shardFor(const std::string& key) {
+    return *shards_[std::hash<std::string>{}(key) % shards_.size()];
+}
+
+void IdempotencyTable::expireLocked(Shard& shard, Clock::time_point now) {
+    while (!shard.order.empty()) {
+        const auto& [key, sequence] = shard.order.front();
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end() && it->second.sequence == sequence) {
+            if (it->second.expires_at > now) {
+                return;
+            }
+            shard.entries.erase(it);
+        }
+        shard.order.pop_front();
+    }
+}
+
+void IdempotencyTable::evictOldestLocked(Shard& shard) {
+    while (!shard.order.empty()) {
+        auto [key, sequence] = std::move(shard.order.front());
+        shard.order.pop_front();
+        auto it = shard.entries.find(key);
+        if (it != shard.entries.end() && it->second.sequence == sequence) {
+            shard.entries.erase(it);
+            evictions_++;
+            return;
+        }
+    }
+}
+
+void IdempotencyTable::forget(Shard& shard, const std::string& key, uint64_t sequence) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(key);
+    if (it != shard.entries.end() && it->second.sequence == sequence) {
+        shard.entries.erase(it);  // The stale FIFO record is skipped when it reaches the front
+    }
+}
+
+}  // namespace cache
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,254 @@
+#include "croupier/sdk/cache/result_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace croupier {
+namespace sdk {
+namespace cache {
+
+namespace {
+
+// Length-prefixed so that no two distinct field lists encode to the same key
+void AppendKeyField(std::string& key, const std::string& field) {
+    key.append(std::to_string(field.size())).push_back(':');
+    key.append(field);
+}
+
+bool IsReadOperation(const std::string& operation) {
+    return operation == "read" || operation == "get" || operation == "list" || operation == "query";
+}
+
+int ParseTTL(const std::map<std::string, std::string>& metadata, const std::string& key, int fallback) {
+    auto it = metadata.find(key);
+    if (it == metadata.end()) {
+        return fallback;
+    }
+    try {
+        return std::stoi(it->second);
+    } catch (const std::exception&) {
+        return fallback;
+    }
+}
+
+}  // namespace
+
+ResultCache::ResultCache(const ResultCacheConfig& config) : config_(config) {
+    if (!config_.enabled || config_.max_entries == 0) {
+        return;
+    }
+    const size_t shard_count = static_cast<size_t>(std::max(1, config_.shards));
+    const size_t per_shard = std::max<size_t>(1, (config_.max_entries + shard_count - 1) / shard_count);
+    shards_.reserve(shard_count);
+    for (size_t i = 0; i < shard_count; ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->slots.resize(per_shard);
+        shard->index.reserve(per_shard);
+        shards_.push_back(std::move(shard));
+    }
+}
+
+void ResultCache::RegisterObject(const VirtualObjectDescriptor& desc) {
+    const int object_ttl = ParseTTL(desc.metadata, "cache_ttl_ms", config_.default_ttl_ms);
+
+    std::vector<std::string> reads;
+    std::vector<std::string> mutations;
+    for (const auto& [operation, function_id] : desc.operations) {
+        if (IsReadOperation(operation)) {
+            reads.push_back(function_id);
+        } else {
+            mutations.push_back(function_id);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(policy_mutex_);
+    for (const auto& function_id : reads) {
+        policies_[function_id].ttl_ms = ParseTTL(desc.metadata, "cache_ttl_ms:" + function_id, object_ttl);
+    }
+    for (const auto& function_id : mutations) {
+        auto& affected = invalidates_[function_id];
+        for (const auto& read : reads) {
+            if (std::find(affected.begin(), affected.end(), read) == affected.end()) {
+                affected.push_back(read);
+            }
+        }
+    }
+}
+
+void ResultCache::SetFunctionTTL(const std::string& function_id, int ttl_ms, size_t max_value_bytes) {
+    std::lock_guard<std::mutex> lock(policy_mutex_);
+    Policy& policy = policies_[function_id];
+    policy.ttl_ms = ttl_ms;
+    policy.max_value_bytes = max_value_bytes;
+}
+
+std::string ResultCache::MakeKey(const std::string& function_id, const InvokeOptions& options,
+                                 const std::string& payload) {
+    size_t size = function_id.size() + options.route.size() + options.target_service_id.size() +
+                  options.hash_key.size() + payload.size() + 32;
+    for (const auto& [name, value] : options.metadata) {
+        size += name.size() + value.size() + 8;
+    }
+
+    std::string key;
+    key.reserve(size);
+    AppendKeyField(key, function_id);
+    AppendKeyField(key, options.route);
+    AppendKeyField(key, options.target_service_id);
+    AppendKeyField(key, options.hash_key);
+    // Metadata carries caller identity (auth tokens, player IDs); std::map keeps the entries sorted
+    key.append(std::to_string(options.metadata.size())).push_back(':');
+    for (const auto& [name, value] : options.metadata) {
+        AppendKeyField(key, name);
+        AppendKeyField(key, value);
+    }
+    AppendKeyField(key, payload);
+    return key;
+}
+
+std::optional<std::string> ResultCache::Get(const std::string& function_id, const std::string& key,
+                                            uint64_t* generation, Clock::time_point now) {
+    if (shards_.empty()) {
+        return std::nullopt;
+    }
+
+    uint64_t current_generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(policy_mutex_);
+        auto it = policies_.find(function_id);
+        if (it == policies_.end() || it->second.ttl_ms <= 0) {
+            return std::nullopt;
+        }
+        current_generation = it->second.generation;
+    }
+    if (generation) {
+        *generation = current_generation;
+    }
+
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        misses_++;
+        return std::nullopt;
+    }
+
+    Slot& slot = shard.slots[it->second];
+    if (slot.generation != current_generation || now >= slot.expires_at) {
+        releaseSlotLocked(shard, it->second);
+        misses_++;
+        return std::nullopt;
+    }
+    slot.referenced = true;
+    hits_++;
+    return slot.value;
+}
+
+void ResultCache::Put(const std::string& function_id, const std::string& key, const std::string& value,
+                      uint64_t generation, Clock::time_point now) {
+    // The key embeds the payload, so it is bounded like the value to keep every slot within 2x the limit
+    if (shards_.empty() || key.size() > config_.max_value_bytes || value.size() > config_.max_value_bytes) {
+        return;
+    }
+
+    int ttl_ms = 0;
+    {
+        std::lock_guard<std::mutex> lock(policy_mutex_);
+        auto it = policies_.find(function_id);
+        // A mutation that completed after Get bumped the generation; storing now would cache stale data.
+        if (it == policies_.end() || it->second.ttl_ms <= 0 || it->second.generation != generation) {
+            return;
+        }
+        if (it->second.max_value_bytes > 0 && value.size() > it->second.max_value_bytes) {
+            return;
+        }
+        ttl_ms = it->second.ttl_ms;
+    }
+
+    Shard& shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size_t index;
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        index = it->second;
+    } else {
+        index = claimSlotLocked(shard);
+        shard.index.emplace(key, index);
+        shard.slots[index].key = key;
+    }
+
+    Slot& slot = shard.slots[index];
+    slot.value = value;
+    slot.expires_at = now + std::chrono::milliseconds(ttl_ms);
+    slot.generation = generation;
+    slot.occupied = true;
+    slot.referenced = false;
+}
+
+void ResultCache::OnInvoked(const std::string& function_id) {
+    std::lock_guard<std::mutex> lock(policy_mutex_);
+    auto it = invalidates_.find(function_id);
+    if (it == invalidates_.end()) {
+        return;
+    }
+    for (const auto& read : it->second) {
+        policies_[read].generation++;
+        invalidations_++;
+    }
+}
+
+void ResultCache::InvalidateFunction(const std::string& function_id) {
+    std::lock_guard<std::mutex> lock(policy_mutex_);
+    auto it = policies_.find(function_id);
+    if (it != policies_.end()) {
+        it->second.generation++;
+        invalidations_++;
+    }
+}
+
+ResultCache::Stats ResultCache::GetStats() const {
+    Stats stats;
+    stats.hits = hits_.load();
+    stats.misses = misses_.load();
+    stats.evictions = evictions_.load();
+    stats.invalidations = invalidations_.load();
+    return stats;
+}
+
+ResultCache::Shard& ResultCache::shardFor(const std::string& key) {
+    return *shards_[std::hash<std::string>{}(key) % shards_.size()];
+}
+
+size_t ResultCache::claimSlotLocked(Shard& shard) {
+    // CLOCK: sweep the hand, giving referenced entries a second chance
+    for (;;) {
+        const size_t candidate = shard.hand;
+        shard.hand = (shard.hand + 1) % shard.slots.size();
+
+        Slot& slot = shard.slots[candidate];
+        if (!slot.occupied) {
+            return candidate;
+        }
+        if (slot.referenced) {
+            slot.referenced = false;
+            continue;
+        }
+        releaseSlotLocked(shard, candidate);
+        evictions_++;
+        return candidate;
+    }
+}
+
+void ResultCache::releaseSlotLocked(Shard& shard, size_t slot_index) {
+    Slot& slot = shard.slots[slot_index];
+    shard.index.erase(slot.key);
+    slot.key.clear();
+    slot.value.clear();
+    slot.occupied = false;
+    slot.referenced = false;
+}
+
+}  // namespace cache
+}  // namespace sdk
+}  // namespace croupier
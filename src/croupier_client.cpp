@@ -1,16 +1,34 @@
 #include "croupier/sdk/croupier_client.h"
 
+#include "croupier/sdk/agent_connection.h"
+#include "croupier/sdk/cache/idempotency_table.h"
+#include "croupier/sdk/cache/result_cache.h"
+#include "croupier/sdk/cache/single_flight.h"
+#include "croupier/sdk/dispatch/dispatch_lane.h"
+#include "croupier/sdk/dispatch/function_table.h"
 #include "croupier/sdk/logger.h"
+#include "croupier/sdk/protocol_messages.h"
+#include "croupier/sdk/registry/function_catalog.h"
+#include "croupier/sdk/resilience/circuit_breaker.h"
+#include "croupier/sdk/resilience/concurrency_limiter.h"
+#include "croupier/sdk/resilience/retry_budget.h"
+#include "croupier/sdk/runtime.h"
 #include "croupier/sdk/tcp_transport.h"
+#include "croupier/sdk/threading/wakeup_fd.h"
 #include "croupier/sdk/utils/json_utils.h"
 #include "croupier/sdk/v1/invocation.pb.h"
 #include "croupier/sdk/v1/provider.pb.h"
 
+#include <google/protobuf/arena.h>
+
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
@@ -20,48 +38,41 @@
 #include <stdexcept>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 
 #ifdef CROUPIER_SDK_ENABLE_JSON
 #include <nlohmann/json.hpp>
 
 // Logging macros with configuration support
-// These check the global logger configuration before outputting
+// These check the global logger configuration before formatting and hand the line to Logger,
+// which writes it directly or through its async queue. Statements below CROUPIER_LOG_MIN_LEVEL
+// compile away, and each statement is rate-limited on its own (Logger::SetRateLimit).
+// SDK_LOG_TRACE additionally drops lines for trace IDs outside Logger::SetTraceSampleRate.
 // Note: These macros support stream-style syntax: SDK_LOG_INFO("value: " << value)
-#define SDK_LOG_INFO(msg)                                                                        \
-    do {                                                                                         \
-        if (!croupier::sdk::Logger::GetInstance().IsEnabled(croupier::sdk::Logger::Level::INFO)) \
-            break;                                                                               \
-        std::ostringstream oss_;                                                                 \
-        oss_ << msg;                                                                             \
-        std::cout << "[INFO] [croupier] " << oss_.str() << '\n';                                 \
-    } while (0)
-
-#define SDK_LOG_WARN(msg)                                                                        \
-    do {                                                                                         \
-        if (!croupier::sdk::Logger::GetInstance().IsEnabled(croupier::sdk::Logger::Level::WARN)) \
-            break;                                                                               \
-        std::ostringstream oss_;                                                                 \
-        oss_ << msg;                                                                             \
-        std::cerr << "[WARN] [croupier] " << oss_.str() << '\n';                                 \
-    } while (0)
-
-#define SDK_LOG_ERROR(msg)                                                                      \
-    do {                                                                                        \
-        if (!croupier::sdk::Logger::GetInstance().IsEnabled(croupier::sdk::Logger::Level::ERR)) \
-            break;                                                                              \
-        std::ostringstream oss_;                                                                \
-        oss_ << msg;                                                                            \
-        std::cerr << "[ERROR] [croupier] " << oss_.str() << '\n';                               \
+#define SDK_LOG_IF(level, sampled, msg)                                 \
+    do {                                                                \
+        using SdkLogLevel_ = croupier::sdk::Logger::Level;              \
+        if (!croupier::sdk::Logger::IsCompiledIn(SdkLogLevel_::level))  \
+            break;                                                      \
+        auto& sdk_logger_ = croupier::sdk::Logger::GetInstance();       \
+        if (!sdk_logger_.IsEnabled(SdkLogLevel_::level) || !(sampled))  \
+            break;                                                      \
+        static croupier::sdk::LogSiteLimiter sdk_log_site_;             \
+        uint64_t suppressed_ = 0;                                       \
+        if (!sdk_log_site_.Allow(sdk_logger_.RateLimit(), suppressed_)) \
+            break;                                                      \
+        std::ostringstream oss_;                                        \
+        oss_ << msg;                                                    \
+        if (suppressed_ > 0)                                            \
+            oss_ << " (suppressed " << suppressed_ << " messages)";     \
+        sdk_logger_.Log(SdkLogLevel_::level, "croupier", oss_.str());   \
     } while (0)
 
-#define SDK_LOG_DEBUG(msg)                                                                        \
-    do {                                                                                          \
-        if (!croupier::sdk::Logger::GetInstance().IsEnabled(croupier::sdk::Logger::Level::DEBUG)) \
-            break;                                                                                \
-        std::ostringstream oss_;                                                                  \
-        oss_ << msg;                                                                              \
-        std::cout << "[DEBUG] [croupier] " << oss_.str() << '\n';                                 \
-    } while (0)
+#define SDK_LOG_INFO(msg) SDK_LOG_IF(INFO, true, msg)
+#define SDK_LOG_WARN(msg) SDK_LOG_IF(WARN, true, msg)
+#define SDK_LOG_ERROR(msg) SDK_LOG_IF(ERR, true, msg)
+#define SDK_LOG_DEBUG(msg) SDK_LOG_IF(DEBUG, true, msg)
+#define SDK_LOG_TRACE(level, trace_id, msg) SDK_LOG_IF(level, sdk_logger_.IsTraceSampled(trace_id), msg)
 
 namespace croupier {
 namespace sdk {
@@ -150,6 +161,32 @@ std::string SerializeMetadataToJson(const google::protobuf::Map<std::string, std
     return json.str();
 }
 
+// CallMetadata over the request's protobuf map; the JSON form is only serialized on demand
+class ProtoCallMetadata : public CallMetadata {
+public:
+    explicit ProtoCallMetadata(const google::protobuf::Map<std::string, std::string>& metadata)
+        : metadata_(metadata) {}
+
+    std::optional<std::string_view> Get(std::string_view key) const override {
+        auto it = metadata_.find(std::string(key));
+        if (it == metadata_.end()) {
+            return std::nullopt;
+        }
+        return std::string_view(it->second);
+    }
+
+    const std::string& Json() const override {
+        if (!json_) {
+            json_ = SerializeMetadataToJson(metadata_);
+        }
+        return *json_;
+    }
+
+private:
+    const google::protobuf::Map<std::string, std::string>& metadata_;
+    mutable std::optional<std::string> json_;
+};
+
 std::string NormalizeProviderJobEventType(const croupier::sdk::v1::JobEvent& event) {
     if (event.type() == "done") {
         return "completed";
@@ -164,22 +201,31 @@ std::string NormalizeProviderJobEventType(const croupier::sdk::v1::JobEvent& eve
     return event.type();
 }
 
-std::vector<uint8_t> SerializeMessage(const google::protobuf::Message& message) {
-    std::string bytes;
-    if (!message.SerializeToString(&bytes)) {
-        throw std::runtime_error("failed to serialize protobuf message");
+// Arena whose first block lives on the stack, so small request/response messages never touch the heap
+template <size_t BlockBytes>
+struct StackArena {
+    alignas(std::max_align_t) char block[BlockBytes];
+    google::protobuf::Arena arena;
+
+    StackArena() : arena(MakeOptions(block)) {}
+
+    template <typename T>
+    T* Create() {
+        return google::protobuf::Arena::CreateMessage<T>(&arena);
     }
-    return std::vector<uint8_t>(bytes.begin(), bytes.end());
-}
 
-template <typename T>
-T ParseMessage(const std::vector<uint8_t>& bytes, const std::string& type_name) {
-    T message;
-    if (!message.ParseFromArray(bytes.data(), static_cast<int>(bytes.size()))) {
-        throw std::runtime_error("failed to parse protobuf message: " + type_name);
+    static google::protobuf::ArenaOptions MakeOptions(char* initial_block) {
+        google::protobuf::ArenaOptions options;
+        options.initial_block = initial_block;
+        options.initial_block_size = BlockBytes;
+        return options;
     }
-    return message;
-}
+};
+
+constexpr size_t kInvokeArenaBytes = 4096;
+
+// How often a replaced agent transport is checked for drained calls
+constexpr std::chrono::milliseconds kTransportReapInterval(10);
 
 JobEvent ToJobEvent(const std::string& job_id, const croupier::sdk::v1::JobEvent& event) {
     JobEvent result;
@@ -301,7 +347,20 @@ class CroupierClient::Impl {
 
     ClientConfig config_;
     std::map<std::string, FunctionHandler> handlers_;
+    std::map<std::string, FunctionViewHandler> view_handlers_;
     std::map<std::string, FunctionDescriptor> descriptors_;
+    registry::FunctionCatalog catalog_;               // Fingerprints of descriptors_
+    registry::FunctionCatalog acknowledged_catalog_;  // What the agent last accepted
+    bool catalog_sync_scheduled_ = false;             // A syncCatalog() task is queued or running
+    mutable std::mutex registry_mutex_;               // Guards the members above; taken before transport_mutex_
+    // Built at Connect and swapped atomically when functions change; handle N is entry N - 1.
+    // Local RPC handlers hold a snapshot for the duration of a call.
+    std::shared_ptr<const dispatch::FunctionTable> function_table_ = std::make_shared<dispatch::FunctionTable>();
+    cache::IdempotencyTable idempotency_;
+    std::shared_ptr<cache::ResultCache> response_cache_;  // Only built if a function sets cache_ttl_ms
+    // One lane per dispatcher named by a FunctionDescriptor, created on its first call
+    std::map<threading::Dispatcher*, std::unique_ptr<dispatch::DispatchLane>> dispatch_lanes_;
+    std::mutex dispatch_lanes_mutex_;
 
     // New: Virtual object and component storage
     std::map<std::string, VirtualObjectDescriptor> objects_;
@@ -311,9 +370,18 @@ class CroupierClient::Impl {
     std::atomic<bool> connected_{false};
     std::thread server_thread_;
     std::string local_address_;
-    std::unique_ptr<TCPTransport> transport_;
+    std::shared_ptr<TCPTransport> transport_;  // Callers take a reference and call without transport_mutex_
+    std::shared_ptr<TransportWatch> transport_watch_;  // Shared-runtime mode only
     std::unique_ptr<TCPServer> server_;
     std::mutex transport_mutex_;
+    // Replaced transports still finishing their calls, closed once drained or past their deadline
+    struct RetiringTransport {
+        std::shared_ptr<TCPTransport> transport;
+        std::chrono::steady_clock::time_point deadline;
+    };
+    std::vector<RetiringTransport> retiring_transports_;  // Guarded by transport_mutex_
+    std::atomic<size_t> retiring_count_{0};
+    Runtime::SourceId reap_timer_ = 0;  // Shared-runtime mode; guarded by transport_mutex_
     std::mutex jobs_mutex_;
     std::unordered_map<std::string, std::shared_ptr<LocalJobState>> jobs_;
     std::string session_id_;
@@ -321,12 +389,32 @@ class CroupierClient::Impl {
     std::atomic<bool> should_stop_heartbeat_{false};
     std::string last_error_;
 
+    // External event loop mode: work posted for ProcessEvents() and the timers it runs
+    std::unique_ptr<threading::WakeupFd> loop_wakeup_;
+    mutable std::mutex loop_mutex_;
+    std::deque<std::function<void()>> loop_queue_;
+    std::optional<std::chrono::steady_clock::time_point> next_heartbeat_;
+    std::atomic<bool> heartbeat_in_flight_{false};
+
+    // Shared-runtime mode: the heartbeat timer (guarded by loop_mutex_) and the jobs posted to the runtime
+    Runtime::SourceId heartbeat_timer_ = 0;
+    TaskGroup runtime_jobs_;
+
+    // Shared-connection mode: this client's tenant on config_.connection
+    AgentConnection::TenantId tenant_ = 0;
+
     // Reconnection state
     std::atomic<bool> is_reconnecting_{false};
     std::atomic<bool> should_stop_reconnecting_{false};
     std::thread reconnect_thread_;
 
-    explicit Impl(const ClientConfig& config) : config_(config) {
+    explicit Impl(const ClientConfig& config) : config_(config), idempotency_(config.idempotency) {
+        if (config_.external_event_loop) {
+            loop_wakeup_ = std::make_unique<threading::WakeupFd>();
+            config_.runtime.reset();
+            config_.connection.reset();
+        }
+
         // ========== Initialize Logger Configuration ==========
         auto& logger = Logger::GetInstance();
 
@@ -337,6 +425,11 @@ class CroupierClient::Impl {
         } else {
             logger.SetLevelFromString(config_.log_level);
         }
+        logger.SetRateLimit(static_cast<uint32_t>(std::max(config_.log_rate_limit, 0)));
+        logger.SetTraceSampleRate(config_.log_trace_sample_rate);
+        if (config_.async_logging) {
+            logger.StartAsync();
+        }
 
         // Validate required configuration
         if (config_.game_id.empty()) {
@@ -352,28 +445,96 @@ class CroupierClient::Impl {
             config_.service_id = "cpp-sdk-" + utils::NewIdempotencyKey().substr(0, 8);
         }
 
+        if (config_.connection) {
+            if (!config_.runtime) {
+                config_.runtime = config_.connection->GetRuntime();
+            }
+            tenant_ = config_.connection->AddTenant(config_.service_id, [this](const std::string& error) {
+                last_error_ = error;
+                connected_ = false;
+                SDK_LOG_WARN("Heartbeat failed: " << error);
+            });
+        }
+
         SDK_LOG_INFO("Initialized CroupierClient for game '" << config_.game_id << "' in '" << config_.env
                                                              << "' environment");
     }
 
-    ~Impl() { Stop(); }
+    ~Impl() {
+        Stop();
+        runtime_jobs_.Wait();
+        if (config_.connection) {
+            config_.connection->RemoveTenant(tenant_);
+        }
+    }
 
     bool RegisterFunction(const FunctionDescriptor& desc, FunctionHandler handler) {
-        if (running_) {
-            SDK_LOG_ERROR("Cannot register functions while client is running");
+        if (!canRegister(desc)) {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            view_handlers_.erase(desc.id);
+            handlers_[desc.id] = std::move(handler);
+            descriptors_[desc.id] = desc;
+            catalog_.Set(desc);
+            if (connected_) {
+                publishCatalogChangeLocked();
+            }
+        }
+
+        SDK_LOG_INFO("Registered function: " << desc.id << " (version: " << desc.version << ")");
+        return true;
+    }
+
+    bool RegisterFunction(const FunctionDescriptor& desc, FunctionViewHandler handler) {
+        if (!canRegister(desc)) {
             return false;
         }
 
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            handlers_.erase(desc.id);
+            view_handlers_[desc.id] = std::move(handler);
+            descriptors_[desc.id] = desc;
+            catalog_.Set(desc);
+            if (connected_) {
+                publishCatalogChangeLocked();
+            }
+        }
+
+        SDK_LOG_INFO("Registered zero-copy function: " << desc.id << " (version: " << desc.version << ")");
+        return true;
+    }
+
+    bool UnregisterFunction(const std::string& function_id) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        if (!eraseFunctionLocked(function_id)) {
+            SDK_LOG_ERROR("Function not found: " << function_id);
+            return false;
+        }
+        if (connected_) {
+            publishCatalogChangeLocked();
+        }
+
+        SDK_LOG_INFO("Unregistered function: " << function_id);
+        return true;
+    }
+
+    bool eraseFunctionLocked(const std::string& function_id) {
+        const bool erased = handlers_.erase(function_id) + view_handlers_.erase(function_id) > 0;
+        descriptors_.erase(function_id);
+        catalog_.Remove(function_id);
+        return erased;
+    }
+
+    bool canRegister(const FunctionDescriptor& desc) const {
         // Validate function ID
         if (desc.id.empty()) {
             SDK_LOG_ERROR("Cannot register function with empty ID");
             return false;
         }
-
-        handlers_[desc.id] = std::move(handler);
-        descriptors_[desc.id] = desc;
-
-        SDK_LOG_INFO("Registered function: " << desc.id << " (version: " << desc.version << ")");
         return true;
     }
 
@@ -398,7 +559,7 @@ class CroupierClient::Impl {
             // Check if handler exists for this function
             auto handler_it = handlers.find(function_id);
             if (handler_it == handlers.end()) {
-                std::cerr << "Missing handler for function: " << function_id << '\n';
+                SDK_LOG_ERROR("Missing handler for function: " << function_id);
                 return false;
             }
 
@@ -409,7 +570,7 @@ class CroupierClient::Impl {
 
             // Register the function
             if (!RegisterFunction(func_desc, handler_it->second)) {
-                std::cerr << "Failed to register function: " << function_id << '\n';
+                SDK_LOG_ERROR("Failed to register function: " << function_id);
                 return false;
             }
         }
@@ -417,21 +578,20 @@ class CroupierClient::Impl {
         // Store virtual object descriptor
         objects_[desc.id] = desc;
 
-        std::cout << "Registered virtual object: " << desc.id << " with " << desc.operations.size() << " operations"
-                  << '\n';
+        SDK_LOG_INFO("Registered virtual object: " << desc.id << " with " << desc.operations.size() << " operations");
         return true;
     }
 
     // New: Register complete component
     bool RegisterComponent(const ComponentDescriptor& comp) {
         if (running_) {
-            std::cerr << "Cannot register components while client is running" << '\n';
+            SDK_LOG_ERROR("Cannot register components while client is running");
             return false;
         }
 
         // Validate component descriptor
         if (!utils::ValidateComponentDescriptor(comp)) {
-            std::cerr << "Invalid component descriptor: " << comp.id << '\n';
+            SDK_LOG_ERROR("Invalid component descriptor: " << comp.id);
             return false;
         }
 
@@ -441,23 +601,23 @@ class CroupierClient::Impl {
         // Register standalone functions first
         for (const auto& func_desc : comp.functions) {
             // This is a placeholder - in real implementation, you would need to provide handlers
-            std::cout << "Note: Standalone function " << func_desc.id << " needs handler registration" << '\n';
+            SDK_LOG_DEBUG("Note: Standalone function " << func_desc.id << " needs handler registration");
         }
 
         // Register virtual objects (they should have handlers already mapped)
         for (const auto& obj_desc : comp.entities) {
             // For entities, we expect handlers to be provided separately
             // This is a design choice - handlers are runtime behavior, descriptors are configuration
-            std::cout << "Registered entity definition: " << obj_desc.id
-                      << " (handlers need to be registered separately)" << '\n';
+            SDK_LOG_INFO("Registered entity definition: " << obj_desc.id
+                                                           << " (handlers need to be registered separately)");
             objects_[obj_desc.id] = obj_desc;
         }
 
         // Store component descriptor
         components_[comp.id] = comp;
 
-        std::cout << "Registered component: " << comp.id << " with " << comp.entities.size() << " entities and "
-                  << comp.functions.size() << " functions" << '\n';
+        SDK_LOG_INFO("Registered component: " << comp.id << " with " << comp.entities.size() << " entities and "
+                                              << comp.functions.size() << " functions");
         return true;
     }
 
@@ -467,7 +627,7 @@ class CroupierClient::Impl {
             ComponentDescriptor comp = utils::LoadComponentDescriptor(config_file);
             return RegisterComponent(comp);
         } catch (const std::exception& e) {
-            std::cerr << "Failed to load component from file " << config_file << ": " << e.what() << '\n';
+            SDK_LOG_ERROR("Failed to load component from file " << config_file << ": " << e.what());
             return false;
         }
     }
@@ -496,22 +656,25 @@ class CroupierClient::Impl {
     bool UnregisterVirtualObject(const std::string& object_id) {
         auto it = objects_.find(object_id);
         if (it == objects_.end()) {
-            std::cerr << "Virtual object not found: " << object_id << '\n';
+            SDK_LOG_ERROR("Virtual object not found: " << object_id);
             return false;
         }
 
         // Remove associated functions
-        const VirtualObjectDescriptor& desc = it->second;
-        for (const auto& op : desc.operations) {
-            const std::string& function_id = op.second;
-            handlers_.erase(function_id);
-            descriptors_.erase(function_id);
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            for (const auto& op : it->second.operations) {
+                eraseFunctionLocked(op.second);
+            }
+            if (connected_) {
+                publishCatalogChangeLocked();
+            }
         }
 
         // Remove object
         objects_.erase(it);
 
-        std::cout << "Unregistered virtual object: " << object_id << '\n';
+        SDK_LOG_INFO("Unregistered virtual object: " << object_id);
         return true;
     }
 
@@ -519,7 +682,7 @@ class CroupierClient::Impl {
     bool UnregisterComponent(const std::string& component_id) {
         auto it = components_.find(component_id);
         if (it == components_.end()) {
-            std::cerr << "Component not found: " << component_id << '\n';
+            SDK_LOG_ERROR("Component not found: " << component_id);
             return false;
         }
 
@@ -531,35 +694,47 @@ class CroupierClient::Impl {
         }
 
         // Remove standalone functions
-        for (const auto& func : comp.functions) {
-            handlers_.erase(func.id);
-            descriptors_.erase(func.id);
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            for (const auto& func : comp.functions) {
+                eraseFunctionLocked(func.id);
+            }
+            if (connected_) {
+                publishCatalogChangeLocked();
+            }
         }
 
         // Remove component
         components_.erase(it);
 
-        std::cout << "Unregistered component: " << component_id << '\n';
+        SDK_LOG_INFO("Unregistered component: " << component_id);
         return true;
     }
 
-    // Re-register all functions
+    // Re-register all functions. The registry lock is held only to snapshot the request, as in syncCatalog().
     void RegisterAllFunctions() {
         if (!connected_) {
             return;
         }
-        try {
-            std::unique_ptr<TCPTransport> replacement =
-                std::make_unique<TCPTransport>(NormalizeTCPAddress(config_.agent_addr), config_.timeout_seconds * 1000);
-            replacement->Connect();
-            std::string session_id = registerWithAgent(*replacement);
-
-            std::lock_guard<std::mutex> lock(transport_mutex_);
-            if (transport_) {
-                transport_->Close();
+        croupier::sdk::v1::RegisterLocalRequest request;
+        registry::FunctionCatalog snapshot;
+        {
+            std::lock_guard<std::mutex> registry_lock(registry_mutex_);
+            auto current = currentTransport();
+            if (current && current->IsConnected() && catalog_.Hash() == acknowledged_catalog_.Hash()) {
+                SDK_LOG_DEBUG("Function catalog unchanged, skipping re-registration");
+                return;
             }
-            transport_ = std::move(replacement);
-            session_id_ = std::move(session_id);
+            request = buildRegisterRequestLocked();
+            snapshot = catalog_;
+        }
+        try {
+            auto replacement = connectAgentTransport();
+            std::string session_id = registerWithAgent(*replacement, request);
+            std::lock_guard<std::mutex> registry_lock(registry_mutex_);
+            acknowledged_catalog_ = std::move(snapshot);
+            replaceTransport(std::move(replacement), std::move(session_id));
+            scheduleCatalogSyncLocked();  // Changes made while registering go out with the next sync
         } catch (const std::exception& e) {
             last_error_ = e.what();
             connected_ = false;
@@ -571,11 +746,14 @@ class CroupierClient::Impl {
         if (connected_)
             return true;
 
+        std::lock_guard<std::mutex> registry_lock(registry_mutex_);
+        rebuildTableLocked();
+        buildResponseCache();
 
         SDK_LOG_INFO("Connecting to server via HTTP/JSON");
         connected_ = true;
         return true;
-        if (handlers_.empty()) {
+        if (currentTable()->Empty()) {
             SDK_LOG_ERROR("Register at least one function before connecting");
             return false;
         }
@@ -583,19 +761,10 @@ class CroupierClient::Impl {
         try {
             startLocalServer();
 
-            auto transport =
-                std::make_unique<TCPTransport>(NormalizeTCPAddress(config_.agent_addr), config_.timeout_seconds * 1000);
-            transport->Connect();
+            auto transport = connectAgentTransport();
             std::string session_id = registerWithAgent(*transport);
-
-            {
-                std::lock_guard<std::mutex> lock(transport_mutex_);
-                if (transport_) {
-                    transport_->Close();
-                }
-                transport_ = std::move(transport);
-                session_id_ = std::move(session_id);
-            }
+            acknowledged_catalog_ = catalog_;
+            replaceTransport(std::move(transport), std::move(session_id));
 
             connected_ = true;
             running_ = true;
@@ -621,15 +790,18 @@ class CroupierClient::Impl {
         }
         running_ = true;
         SDK_LOG_INFO("Croupier client service started");
-        SDK_LOG_INFO("Registered functions: " << handlers_.size());
-        std::cout << "📦 已RegisterVirtual Object: " << objects_.size() << " 个" << '\n';
-        std::cout << "🔧 已RegisterComponent: " << components_.size() << " 个" << '\n';
-        std::cout << "💡 使用 Stop() 方法StopService" << '\n';
-        std::cout << "===============================================" << '\n';
+        SDK_LOG_INFO("Registered functions: " << handlers_.size() + view_handlers_.size());
+        SDK_LOG_INFO("📦 已RegisterVirtual Object: " << objects_.size() << " 个");
+        SDK_LOG_INFO("🔧 已RegisterComponent: " << components_.size() << " 个");
+        SDK_LOG_INFO("💡 使用 Stop() 方法StopService");
 
         // Keep service running
         while (running_) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (loop_wakeup_) {
+                PollOnce(100);
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
         }
 
         SDK_LOG_INFO("Service stopped");
@@ -660,6 +832,11 @@ class CroupierClient::Impl {
         closeTransport();
         stopLocalServer();
         session_id_.clear();
+        {
+            // A new session starts with an empty catalog on the agent side
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            acknowledged_catalog_.Clear();
+        }
 
         SDK_LOG_INFO("Client fully stopped");
     }
@@ -680,12 +857,142 @@ class CroupierClient::Impl {
                 job->worker.join();
             }
         }
+        runtime_jobs_.Wait();
+        {
+            std::lock_guard<std::mutex> lock(loop_mutex_);
+            loop_queue_.clear();
+        }
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        catalog_sync_scheduled_ = false;  // The loop queue holding the sync task was just dropped
+        std::atomic_store(&function_table_,
+                          std::shared_ptr<const dispatch::FunctionTable>(std::make_shared<dispatch::FunctionTable>()));
+        std::atomic_store(&response_cache_, std::shared_ptr<cache::ResultCache>());
         handlers_.clear();
+        view_handlers_.clear();
         descriptors_.clear();
+        catalog_.Clear();
     }
 
     std::string GetLocalAddress() const { return local_address_; }
 
+    uint64_t GetCatalogHash() const {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        return catalog_.Hash();
+    }
+
+    CacheStats GetResponseCacheStats() const {
+        const auto response_cache = std::atomic_load(&response_cache_);
+        return response_cache ? response_cache->GetStats() : CacheStats{};
+    }
+
+    std::shared_ptr<const dispatch::FunctionTable> currentTable() const { return std::atomic_load(&function_table_); }
+
+    // Rebuilding from the current table keeps existing handles stable across changes and reconnects
+    void rebuildTableLocked() {
+        std::shared_ptr<const dispatch::FunctionTable> table = std::make_shared<dispatch::FunctionTable>(
+            handlers_, view_handlers_, descriptors_, currentTable().get());
+        std::atomic_store(&function_table_, std::move(table));
+    }
+
+    // Apply a registration change made after Connect: swap in a table that keeps existing handles at once,
+    // and leave telling the agent to a background sync so a burst of changes is re-registered together
+    void publishCatalogChangeLocked() {
+        rebuildTableLocked();
+        // Cached responses may come from a handler that was just replaced, so start over
+        buildResponseCache();
+        scheduleCatalogSyncLocked();
+    }
+
+    void scheduleCatalogSyncLocked() {
+        if (catalog_sync_scheduled_ || catalog_.Hash() == acknowledged_catalog_.Hash()) {
+            return;  // A queued or running sync re-reads the catalog before it finishes
+        }
+        catalog_sync_scheduled_ = true;
+        if (loop_wakeup_) {
+            postToLoop([this]() { syncCatalog(); });
+        } else if (config_.runtime) {
+            runtime_jobs_.Post(*config_.runtime, [this]() { syncCatalog(); });
+        }
+        // Otherwise the heartbeat thread syncs on its next tick
+    }
+
+    // Re-register until the agent has acknowledged the current catalog. The agent only accepts a full
+    // RegisterLocal, so each round sends every function; changes made while a round is in flight are
+    // batched into the next one. The registry lock is held only to snapshot the request.
+    void syncCatalog() {
+        for (;;) {
+            croupier::sdk::v1::RegisterLocalRequest request;
+            registry::FunctionCatalog snapshot;
+            registry::CatalogDelta delta;
+            std::shared_ptr<TCPTransport> transport;
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex_);
+                transport = currentTransport();
+                if (!connected_ || catalog_.Hash() == acknowledged_catalog_.Hash() || !transport ||
+                    !transport->IsConnected()) {
+                    catalog_sync_scheduled_ = false;  // Without a transport, Connect registers in full
+                    return;
+                }
+                request = buildRegisterRequestLocked();
+                snapshot = catalog_;
+                delta = snapshot.Diff(acknowledged_catalog_);
+            }
+
+            SDK_LOG_INFO("Function catalog changed (" << delta.added.size() << " added, " << delta.changed.size()
+                                                      << " changed, " << delta.removed.size()
+                                                      << " removed), re-registering all " << request.functions_size()
+                                                      << " functions");
+            std::string session_id;
+            try {
+                session_id = registerWithAgent(*transport, request);
+            } catch (const std::exception& e) {
+                last_error_ = e.what();
+                SDK_LOG_ERROR("Failed to register function catalog change: " << last_error_);
+                std::lock_guard<std::mutex> lock(registry_mutex_);
+                catalog_sync_scheduled_ = false;
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            std::lock_guard<std::mutex> transport_lock(transport_mutex_);
+            if (transport_ != transport) {
+                continue;  // Reconnected meanwhile; that registration superseded this one
+            }
+            acknowledged_catalog_ = std::move(snapshot);
+            session_id_ = std::move(session_id);
+        }
+    }
+
+    bool catalogSyncScheduled() const {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        return catalog_sync_scheduled_;
+    }
+
+    void buildResponseCache() {
+        std::atomic_store(&response_cache_, std::shared_ptr<cache::ResultCache>());
+        ResultCacheConfig cache_config;
+        cache_config.enabled = true;
+        cache_config.max_entries = config_.response_cache_max_entries;
+        cache_config.shards = config_.response_cache_shards;
+        cache_config.max_value_bytes = 0;
+        for (const auto& [function_id, desc] : descriptors_) {
+            if (desc.cache_ttl_ms > 0) {
+                cache_config.max_value_bytes = std::max(cache_config.max_value_bytes, desc.cache_max_entry_bytes);
+            }
+        }
+        if (cache_config.max_value_bytes == 0) {
+            return;
+        }
+
+        auto response_cache = std::make_shared<cache::ResultCache>(cache_config);
+        for (const auto& [function_id, desc] : descriptors_) {
+            if (desc.cache_ttl_ms > 0) {
+                response_cache->SetFunctionTTL(function_id, desc.cache_ttl_ms, desc.cache_max_entry_bytes);
+            }
+        }
+        std::atomic_store(&response_cache_, std::move(response_cache));
+    }
+
     bool IsConnected() const { return connected_; }
 
     void startLocalServer() {
@@ -696,23 +1003,18 @@ class CroupierClient::Impl {
         local_address_ = ResolveLocalListenAddress(config_.local_listen);
         auto server = std::make_unique<TCPServer>(local_address_, config_.timeout_seconds * 1000);
         server->SetHandler([this](uint32_t msg_type, uint32_t /*req_id*/, const std::vector<uint8_t>& body) {
-            switch (msg_type) {
-            case protocol::MSG_INVOKE_REQUEST:
-                return handleInvoke(body);
-            case protocol::MSG_START_JOB_REQUEST:
-                return handleStartJob(body);
-            case protocol::MSG_STREAM_JOB_REQUEST:
-                return handleStreamJob(body);
-            case protocol::MSG_CANCEL_JOB_REQUEST:
-                return handleCancelJob(body);
-            default:
-                throw std::runtime_error("unsupported local RPC message: " + protocol::MsgIDString(msg_type));
-            }
+            return HandleLocalRequest(msg_type, body);
         });
         server->Start();
         server_ = std::move(server);
     }
 
+    std::vector<uint8_t> HandleLocalRequest(uint32_t msg_type, const std::vector<uint8_t>& body) {
+        return protocol::DispatchAny<protocol::MSG_INVOKE_REQUEST, protocol::MSG_START_JOB_REQUEST,
+                                     protocol::MSG_STREAM_JOB_REQUEST, protocol::MSG_CANCEL_JOB_REQUEST>(
+            msg_type, body, [this](auto tag, const auto& request) { return handle(tag, request); });
+    }
+
     void stopLocalServer() {
         if (server_) {
             server_->Stop();
@@ -721,22 +1023,155 @@ class CroupierClient::Impl {
     }
 
     void closeTransport() {
+        std::shared_ptr<TCPTransport> transport;
+        std::shared_ptr<TransportWatch> watch;
+        Runtime::SourceId reap_timer = 0;
+        {
+            std::lock_guard<std::mutex> lock(transport_mutex_);
+            transport = std::move(transport_);
+            watch = std::move(transport_watch_);
+            reap_timer = std::exchange(reap_timer_, 0);
+        }
+        if (reap_timer != 0) {
+            config_.runtime->Cancel(reap_timer);
+        }
+        reapRetiredTransports(true);
+        if (watch) {
+            watch->Stop();
+        }
+        if (transport && !config_.connection) {
+            transport->Close();
+        }
+    }
+
+    std::shared_ptr<TCPTransport> connectAgentTransport() {
+        if (config_.connection) {
+            return config_.connection->Acquire();
+        }
+        auto transport =
+            std::make_shared<TCPTransport>(NormalizeTCPAddress(config_.agent_addr), config_.timeout_seconds * 1000);
+        transport->SetPolled(config_.external_event_loop || config_.runtime);
+        transport->Connect();
+        return transport;
+    }
+
+    std::shared_ptr<TCPTransport> currentTransport() {
         std::lock_guard<std::mutex> lock(transport_mutex_);
-        if (transport_) {
-            transport_->Close();
-            transport_.reset();
+        return transport_;
+    }
+
+    // Make-before-break: new calls use the replacement at once, while calls already waiting on the
+    // previous transport get up to transport_drain_timeout_ms to complete before it is closed. The
+    // previous transport is retired in the background so reconnecting never waits for its calls.
+    void replaceTransport(std::shared_ptr<TCPTransport> replacement, std::string session_id) {
+        std::shared_ptr<TransportWatch> watch;
+        if (config_.runtime && !config_.connection && replacement) {
+            watch = TransportWatch::Start(config_.runtime, *replacement);
+        }
+
+        std::shared_ptr<TCPTransport> previous;
+        std::shared_ptr<TransportWatch> previous_watch;
+        {
+            std::lock_guard<std::mutex> lock(transport_mutex_);
+            previous = std::exchange(transport_, std::move(replacement));
+            previous_watch = std::exchange(transport_watch_, std::move(watch));
+            session_id_ = std::move(session_id);
+            if (config_.connection) {
+                config_.connection->SetSession(tenant_, session_id_);  // Re-registration renews the session
+            }
+        }
+        if (previous_watch) {
+            previous_watch->Stop();  // Callers still waiting on the previous transport read it themselves
+        }
+        if (!previous || config_.connection) {
+            return;  // A shared transport is closed by its AgentConnection
+        }
+        if (previous->PendingCalls() == 0) {
+            previous->Close();
+            return;
+        }
+        retireTransport(std::move(previous));
+    }
+
+    // Reaped by a runtime timer, by ProcessEvents() or by the heartbeat thread, whichever this mode runs
+    void retireTransport(std::shared_ptr<TCPTransport> transport) {
+        const auto drain_timeout = std::chrono::milliseconds(std::max(0, config_.transport_drain_timeout_ms));
+        const auto deadline = std::chrono::steady_clock::now() + drain_timeout;
+        std::lock_guard<std::mutex> lock(transport_mutex_);
+        retiring_transports_.push_back({std::move(transport), deadline});
+        retiring_count_ = retiring_transports_.size();
+        if (config_.runtime && reap_timer_ == 0) {
+            reap_timer_ = config_.runtime->SchedulePeriodic(kTransportReapInterval, [this]() {
+                reapRetiredTransports();
+                Runtime::SourceId timer = 0;
+                {
+                    // Checked under the lock retireTransport takes, so a newly retired transport keeps the timer
+                    std::lock_guard<std::mutex> timer_lock(transport_mutex_);
+                    if (!retiring_transports_.empty()) {
+                        return;
+                    }
+                    timer = std::exchange(reap_timer_, 0);
+                }
+                if (timer != 0) {
+                    config_.runtime->Cancel(timer);
+                }
+            });
+        }
+    }
+
+    // Close retired transports whose calls finished or whose drain deadline passed (all of them if force)
+    void reapRetiredTransports(bool force = false) {
+        if (retiring_count_ == 0) {
+            return;
+        }
+        std::vector<std::shared_ptr<TCPTransport>> to_close;
+        {
+            std::lock_guard<std::mutex> lock(transport_mutex_);
+            const auto now = std::chrono::steady_clock::now();
+            auto done = std::stable_partition(
+                retiring_transports_.begin(), retiring_transports_.end(), [&](const RetiringTransport& retiring) {
+                    return !force && retiring.transport->PendingCalls() > 0 && now < retiring.deadline;
+                });
+            for (auto it = done; it != retiring_transports_.end(); ++it) {
+                to_close.push_back(std::move(it->transport));
+            }
+            retiring_transports_.erase(done, retiring_transports_.end());
+            retiring_count_ = retiring_transports_.size();
+        }
+        for (const auto& transport : to_close) {
+            if (const size_t pending = transport->PendingCalls()) {
+                SDK_LOG_WARN("Closing replaced agent connection with " << pending << " calls still pending");
+            }
+            transport->Close();
         }
     }
 
     std::string registerWithAgent(TCPTransport& transport) {
+        return registerWithAgent(transport, buildRegisterRequestLocked());
+    }
+
+    std::string registerWithAgent(TCPTransport& transport, const croupier::sdk::v1::RegisterLocalRequest& request) {
+        auto response = protocol::Call<protocol::MSG_REGISTER_LOCAL_REQUEST>(transport, request);
+        if (response.session_id().empty()) {
+            throw std::runtime_error("RegisterLocal returned empty session_id");
+        }
+        return response.session_id();
+    }
+
+    croupier::sdk::v1::RegisterLocalRequest buildRegisterRequestLocked() const {
         croupier::sdk::v1::RegisterLocalRequest request;
         request.set_service_id(config_.service_id);
         request.set_version(config_.service_version);
         request.set_rpc_addr(local_address_);
 
-        for (const auto& [function_id, desc] : descriptors_) {
+        const auto table = currentTable();
+        for (const auto& entry : table->Entries()) {
+            if (!entry.Live()) {
+                continue;
+            }
+            const FunctionDescriptor& desc = descriptors_.at(entry.function_id);
             auto* fn = request.add_functions();
-            fn->set_id(function_id);
+            fn->set_id(entry.function_id);
             fn->set_version(desc.version);
             for (const auto& tag : desc.tags) {
                 fn->add_tags(tag);
@@ -758,24 +1193,121 @@ class CroupierClient::Impl {
                 fn->set_output_schema(desc.output_schema);
             }
         }
+        return request;
+    }
 
-        auto [_, response_body] = transport.Call(protocol::MSG_REGISTER_LOCAL_REQUEST, SerializeMessage(request));
-        auto response =
-            ParseMessage<croupier::sdk::v1::RegisterLocalResponse>(response_body, "RegisterLocalResponse");
-        if (response.session_id().empty()) {
-            throw std::runtime_error("RegisterLocal returned empty session_id");
+    int GetEventFd() const { return loop_wakeup_ ? loop_wakeup_->Fd() : -1; }
+
+    int NextTimeoutMs() const {
+        const int reap_ms = retiring_count_ > 0 ? static_cast<int>(kTransportReapInterval.count()) : -1;
+        std::lock_guard<std::mutex> lock(loop_mutex_);
+        if (!next_heartbeat_) {
+            return reap_ms;
         }
-        return response.session_id();
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            *next_heartbeat_ - std::chrono::steady_clock::now());
+        const int heartbeat_ms = static_cast<int>(std::max<int64_t>(0, remaining.count()));
+        return reap_ms >= 0 ? std::min(reap_ms, heartbeat_ms) : heartbeat_ms;
+    }
+
+    int ProcessEvents() {
+        if (!loop_wakeup_) {
+            return 0;
+        }
+
+        loop_wakeup_->Clear();
+        std::deque<std::function<void()>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(loop_mutex_);
+            tasks.swap(loop_queue_);
+        }
+        int processed = static_cast<int>(tasks.size());
+        for (auto& task : tasks) {
+            task();
+        }
+
+        if (auto transport = currentTransport()) {
+            processed += transport->ProcessIncoming();
+        }
+        reapRetiredTransports();
+
+        bool heartbeat_due = false;
+        {
+            std::lock_guard<std::mutex> lock(loop_mutex_);
+            if (next_heartbeat_ && std::chrono::steady_clock::now() >= *next_heartbeat_) {
+                heartbeat_due = true;
+                next_heartbeat_ = std::chrono::steady_clock::now() + heartbeatInterval();
+            }
+        }
+        if (heartbeat_due) {
+            processed++;
+            sendLoopHeartbeat();
+        }
+        return processed;
+    }
+
+    int PollOnce(int timeout_ms) {
+        if (!loop_wakeup_) {
+            return 0;
+        }
+        const int next_timer = NextTimeoutMs();
+        if (next_timer >= 0 && (timeout_ms < 0 || next_timer < timeout_ms)) {
+            timeout_ms = next_timer;
+        }
+        loop_wakeup_->Wait(timeout_ms);
+        return ProcessEvents();
+    }
+
+    // Run task on the host's loop thread at the next ProcessEvents()
+    void postToLoop(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(loop_mutex_);
+            loop_queue_.push_back(std::move(task));
+        }
+        loop_wakeup_->Notify();
+    }
+
+    std::chrono::milliseconds heartbeatInterval() const {
+        return std::chrono::seconds(std::max(1, config_.heartbeat_interval));
     }
 
     void startHeartbeatLoop() {
         stopHeartbeatLoop();
+        if (config_.connection) {
+            std::lock_guard<std::mutex> lock(transport_mutex_);
+            config_.connection->SetSession(tenant_, session_id_);
+            return;
+        }
+        if (loop_wakeup_) {
+            std::lock_guard<std::mutex> lock(loop_mutex_);
+            next_heartbeat_ = std::chrono::steady_clock::now() + heartbeatInterval();
+            return;
+        }
+        if (config_.runtime) {
+            std::lock_guard<std::mutex> lock(loop_mutex_);
+            heartbeat_timer_ = config_.runtime->SchedulePeriodic(heartbeatInterval(), [this]() {
+                try {
+                    sendHeartbeat();
+                } catch (const std::exception& e) {
+                    last_error_ = e.what();
+                    connected_ = false;
+                    SDK_LOG_WARN("Heartbeat failed: " << last_error_);
+                    stopHeartbeatLoop();
+                }
+            });
+            return;
+        }
         should_stop_heartbeat_ = false;
         heartbeat_thread_ = std::thread([this]() {
             const auto interval = std::max(1, config_.heartbeat_interval);
             while (!should_stop_heartbeat_) {
                 for (int elapsed = 0; elapsed < interval * 10 && !should_stop_heartbeat_; ++elapsed) {
                     std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    // Catalog changes of the last tick are re-registered together
+                    if (catalogSyncScheduled()) {
+                        syncCatalog();
+                    }
+                    reapRetiredTransports();
                 }
                 if (should_stop_heartbeat_) {
                     break;
@@ -794,6 +1326,18 @@ class CroupierClient::Impl {
     }
 
     void stopHeartbeatLoop() {
+        Runtime::SourceId timer = 0;
+        {
+            std::lock_guard<std::mutex> lock(loop_mutex_);
+            next_heartbeat_.reset();
+            timer = std::exchange(heartbeat_timer_, 0);
+        }
+        if (timer != 0) {
+            config_.runtime->Cancel(timer);
+        }
+        if (config_.connection) {
+            config_.connection->SetSession(tenant_, std::string());
+        }
         should_stop_heartbeat_ = true;
         if (heartbeat_thread_.joinable()) {
             heartbeat_thread_.join();
@@ -803,36 +1347,156 @@ class CroupierClient::Impl {
     void sendHeartbeat() {
         croupier::sdk::v1::HeartbeatRequest request;
         request.set_service_id(config_.service_id);
-        request.set_session_id(session_id_);
 
-        std::lock_guard<std::mutex> lock(transport_mutex_);
-        if (!transport_ || !transport_->IsConnected()) {
+        std::shared_ptr<TCPTransport> transport;
+        {
+            std::lock_guard<std::mutex> lock(transport_mutex_);
+            transport = transport_;
+            request.set_session_id(session_id_);
+        }
+        if (!transport || !transport->IsConnected()) {
             throw std::runtime_error("heartbeat transport is not connected");
         }
-        transport_->Call(protocol::MSG_HEARTBEAT_LOCAL_REQUEST, SerializeMessage(request));
+        protocol::Call<protocol::MSG_HEARTBEAT_LOCAL_REQUEST>(*transport, request);
     }
 
-    std::vector<uint8_t> handleInvoke(const std::vector<uint8_t>& body) {
-        auto request = ParseMessage<croupier::sdk::v1::InvokeRequest>(body, "InvokeRequest");
-        auto handler_it = handlers_.find(request.function_id());
-        if (handler_it == handlers_.end()) {
-            throw std::runtime_error("function not found: " + request.function_id());
+    // Loop mode: the reply is routed by a later ProcessEvents() instead of blocking the host's loop for it
+    void sendLoopHeartbeat() {
+        if (heartbeat_in_flight_.exchange(true)) {
+            return;  // The previous heartbeat is still waiting for its reply or its timeout
         }
+        croupier::sdk::v1::HeartbeatRequest request;
+        request.set_service_id(config_.service_id);
 
-        croupier::sdk::v1::InvokeResponse response;
-        response.set_payload(handler_it->second(SerializeMetadataToJson(request.metadata()), request.payload()));
-        return SerializeMessage(response);
+        std::shared_ptr<TCPTransport> transport;
+        {
+            std::lock_guard<std::mutex> lock(transport_mutex_);
+            transport = transport_;
+            request.set_session_id(session_id_);
+        }
+        if (!transport || !transport->IsConnected()) {
+            heartbeat_in_flight_ = false;
+            onLoopHeartbeatFailed("heartbeat transport is not connected");
+            return;
+        }
+        const TCPTransport* sent_on = transport.get();
+        auto sent = transport->CallAsync(
+            protocol::MSG_HEARTBEAT_LOCAL_REQUEST, protocol::EncodeBody(request),
+            [this, sent_on](Result<std::pair<uint32_t, std::vector<uint8_t>>> reply) {
+                heartbeat_in_flight_ = false;
+                // A transport replaced meanwhile fails its heartbeat when it is closed; that is no failure of ours
+                if (!reply && currentTransport().get() == sent_on) {
+                    onLoopHeartbeatFailed(reply.error().message);
+                }
+            });
+        if (!sent) {
+            heartbeat_in_flight_ = false;
+            onLoopHeartbeatFailed(sent.error().message);
+        }
     }
 
-    std::vector<uint8_t> handleStartJob(const std::vector<uint8_t>& body) {
-        auto request = ParseMessage<croupier::sdk::v1::InvokeRequest>(body, "InvokeRequest");
-        auto handler_it = handlers_.find(request.function_id());
-        if (handler_it == handlers_.end()) {
+    void onLoopHeartbeatFailed(const std::string& error) {
+        last_error_ = error;
+        connected_ = false;
+        SDK_LOG_WARN("Heartbeat failed: " << last_error_);
+        std::lock_guard<std::mutex> lock(loop_mutex_);
+        next_heartbeat_.reset();
+    }
+
+    // Local RPC handlers, selected per MsgID by protocol::DispatchAny
+    croupier::sdk::v1::InvokeResponse handle(protocol::MsgTag<protocol::MSG_INVOKE_REQUEST>,
+                                             const croupier::sdk::v1::InvokeRequest& request) {
+        const auto table = currentTable();
+        const auto* function = table->Find(request.function_id());
+        if (!function) {
+            throw std::runtime_error("function not found: " + request.function_id());
+        }
+
+        croupier::sdk::v1::InvokeResponse response;
+
+        // Pure functions answer repeated payloads from the response cache without running the handler
+        std::shared_ptr<cache::ResultCache> response_cache;
+        std::string cache_key;
+        uint64_t generation = 0;
+        if (function->cache_ttl_ms > 0 && (response_cache = std::atomic_load(&response_cache_))) {
+            static const InvokeOptions kNoRouting;
+            cache_key = cache::ResultCache::MakeKey(function->function_id, kNoRouting, request.payload());
+            if (auto cached = response_cache->Get(function->function_id, cache_key, &generation)) {
+                response.set_payload(std::move(*cached));
+                return response;
+            }
+        }
+
+        if (idempotency_.Enabled() && !request.idempotency_key().empty()) {
+            // Retries of the same call replay the first response instead of running the handler again
+            const std::string key = cache::IdempotencyTable::MakeKey(function->function_id, request.idempotency_key());
+            response.set_payload(idempotency_.Execute(key, [&]() {
+                std::string payload;
+                runHandler(*function, request, payload);
+                return payload;
+            }));
+        } else {
+            runHandler(*function, request, *response.mutable_payload());
+        }
+
+        if (!cache_key.empty()) {
+            response_cache->Put(function->function_id, cache_key, response.payload(), generation);
+        }
+        return response;
+    }
+
+    // Run the handler on the caller's thread, or on the dispatcher its descriptor names
+    void runHandler(const dispatch::FunctionTable::Entry& function, const croupier::sdk::v1::InvokeRequest& request,
+                    std::string& output) {
+        if (!function.dispatcher) {
+            runFunction(function, request, output);
+            return;
+        }
+        const auto deadline = std::chrono::steady_clock::now() + dispatchDeadline(function);
+        // The lane only starts the work while this call is still waiting for it, so borrowing is safe
+        auto work = [&function, &request]() {
+            std::string result;
+            runFunction(function, request, result);
+            return result;
+        };
+        output = dispatchLane(*function.dispatcher).Run(std::move(work), deadline);
+    }
+
+    std::chrono::milliseconds dispatchDeadline(const dispatch::FunctionTable::Entry& function) const {
+        return std::chrono::milliseconds(function.dispatch_deadline_ms > 0 ? function.dispatch_deadline_ms
+                                                                           : config_.timeout_seconds * 1000);
+    }
+
+    dispatch::DispatchLane& dispatchLane(threading::Dispatcher& dispatcher) {
+        std::lock_guard<std::mutex> lock(dispatch_lanes_mutex_);
+        auto& lane = dispatch_lanes_[&dispatcher];
+        if (!lane) {
+            lane = std::make_unique<dispatch::DispatchLane>(dispatcher, config_.dispatch_max_invocations_per_frame);
+        }
+        return *lane;
+    }
+
+    static void runFunction(const dispatch::FunctionTable::Entry& function,
+                            const croupier::sdk::v1::InvokeRequest& request, std::string& output) {
+        if (function.view_handler) {
+            ProtoCallMetadata metadata(request.metadata());
+            ResponseWriter out(output);
+            function.view_handler(metadata, request.payload(), out);
+        } else {
+            output = function.handler(SerializeMetadataToJson(request.metadata()), request.payload());
+        }
+    }
+
+    croupier::sdk::v1::StartJobResponse handle(protocol::MsgTag<protocol::MSG_START_JOB_REQUEST>,
+                                               const croupier::sdk::v1::InvokeRequest& request) {
+        const auto table = currentTable();
+        const auto* function = table->Find(request.function_id());
+        if (!function) {
             throw std::runtime_error("function not found: " + request.function_id());
         }
 
         auto job = std::make_shared<LocalJobState>();
-        job->job_id = request.function_id() + "-" + utils::NewIdempotencyKey().substr(0, 12);
+        job->job_id = function->function_id + "-" + utils::NewIdempotencyKey().substr(0, 12);
 
         JobEvent started;
         started.event_type = "started";
@@ -846,53 +1510,79 @@ class CroupierClient::Impl {
             jobs_[job->job_id] = job;
         }
 
-        const std::string metadata_json = SerializeMetadataToJson(request.metadata());
-        const std::string payload = request.payload();
-        auto handler = handler_it->second;
-        job->worker = std::thread([this, job, handler, metadata_json, payload]() {
-            try {
-                const std::string result = handler(metadata_json, payload);
-                if (job->cancelled) {
-                    return;
-                }
+        // The job outlives the request, so it runs on copies of the metadata and payload
+        std::function<std::string()> run;
+        if (function->view_handler) {
+            run = [handler = function->view_handler, metadata = request.metadata(), payload = request.payload()]() {
+                ProtoCallMetadata call_metadata(metadata);
+                std::string result;
+                ResponseWriter out(result);
+                handler(call_metadata, payload, out);
+                return result;
+            };
+        } else {
+            run = [handler = function->handler, metadata_json = SerializeMetadataToJson(request.metadata()),
+                   payload = request.payload()]() { return handler(metadata_json, payload); };
+        }
+        if (function->dispatcher) {
+            // The job thread only waits; the handler itself still runs on its dispatcher
+            run = [this, dispatcher = function->dispatcher, timeout = dispatchDeadline(*function),
+                   handler_run = std::move(run)]() {
+                return dispatchLane(*dispatcher).Run(handler_run, std::chrono::steady_clock::now() + timeout);
+            };
+        }
+        if (loop_wakeup_) {
+            postToLoop([this, job, run = std::move(run)]() { runProviderJob(job, run); });
+        } else if (config_.runtime) {
+            runtime_jobs_.Post(*config_.runtime, [this, job, run = std::move(run)]() { runProviderJob(job, run); });
+        } else {
+            job->worker = std::thread([this, job, run = std::move(run)]() { runProviderJob(job, run); });
+        }
 
-                JobEvent completed;
-                completed.event_type = "completed";
-                completed.job_id = job->job_id;
-                completed.message = "job completed";
-                completed.progress = 100;
-                completed.payload = result;
-                completed.done = true;
-                appendProviderJobEvent(job, completed);
-            } catch (const std::exception& e) {
-                if (job->cancelled) {
-                    return;
-                }
+        croupier::sdk::v1::StartJobResponse response;
+        response.set_job_id(job->job_id);
+        return response;
+    }
 
-                JobEvent error;
-                error.event_type = "error";
-                error.job_id = job->job_id;
-                error.message = e.what();
-                error.error = e.what();
-                error.done = true;
-                appendProviderJobEvent(job, error);
+    void runProviderJob(const std::shared_ptr<LocalJobState>& job, const std::function<std::string()>& run) {
+        try {
+            const std::string result = run();
+            if (job->cancelled) {
+                return;
             }
-        });
 
-        croupier::sdk::v1::StartJobResponse response;
-        response.set_job_id(job->job_id);
-        return SerializeMessage(response);
+            JobEvent completed;
+            completed.event_type = "completed";
+            completed.job_id = job->job_id;
+            completed.message = "job completed";
+            completed.progress = 100;
+            completed.payload = result;
+            completed.done = true;
+            appendProviderJobEvent(job, completed);
+        } catch (const std::exception& e) {
+            if (job->cancelled) {
+                return;
+            }
+
+            JobEvent error;
+            error.event_type = "error";
+            error.job_id = job->job_id;
+            error.message = e.what();
+            error.error = e.what();
+            error.done = true;
+            appendProviderJobEvent(job, error);
+        }
     }
 
-    std::vector<uint8_t> handleStreamJob(const std::vector<uint8_t>& body) {
-        auto request = ParseMessage<croupier::sdk::v1::JobStreamRequest>(body, "JobStreamRequest");
+    croupier::sdk::v1::JobEvent handle(protocol::MsgTag<protocol::MSG_STREAM_JOB_REQUEST>,
+                                       const croupier::sdk::v1::JobStreamRequest& request) {
         croupier::sdk::v1::JobEvent response;
 
         auto job = findProviderJob(request.job_id());
         if (!job) {
             response.set_type("error");
             response.set_message("job not found");
-            return SerializeMessage(response);
+            return response;
         }
 
         JobEvent latest;
@@ -907,11 +1597,11 @@ class CroupierClient::Impl {
         response.set_message(latest.error.empty() ? latest.message : latest.error);
         response.set_progress(latest.progress);
         response.set_payload(latest.payload);
-        return SerializeMessage(response);
+        return response;
     }
 
-    std::vector<uint8_t> handleCancelJob(const std::vector<uint8_t>& body) {
-        auto request = ParseMessage<croupier::sdk::v1::CancelJobRequest>(body, "CancelJobRequest");
+    void handle(protocol::MsgTag<protocol::MSG_CANCEL_JOB_REQUEST>,
+                const croupier::sdk::v1::CancelJobRequest& request) {
         auto job = findProviderJob(request.job_id());
 
         if (job && !job->done) {
@@ -924,8 +1614,6 @@ class CroupierClient::Impl {
             cancelled.done = true;
             appendProviderJobEvent(job, cancelled);
         }
-
-        return {};
     }
 
     std::shared_ptr<LocalJobState> findProviderJob(const std::string& job_id) {
@@ -957,18 +1645,43 @@ class CroupierInvoker::Impl {
         std::atomic<bool> done{false};
         std::atomic<bool> cancelled{false};
         std::thread worker;
+        Runtime::SourceId step_timer = 0;  // Shared-runtime mode: timer starting the next step (guarded by jobs_mutex_)
+        // Jobs this invoker runs itself: StreamJob callers wait here and appendJobEvent completes them
+        bool runs_locally = false;
+        std::vector<std::promise<std::vector<JobEvent>>> subscribers;  // Guarded by jobs_mutex_
+    };
+
+    // One poller per job ID; every concurrent StreamJob caller subscribes to its result
+    struct JobStream {
+        std::vector<std::promise<std::vector<JobEvent>>> subscribers;
+        std::thread poller;
     };
 
     InvokerConfig config_;
     ReconnectConfig reconnect_config_;
     RetryConfig retry_config_;
+    resilience::RetryBudget retry_budget_;
+    resilience::ConcurrencyLimiterRegistry limiters_;
+    resilience::CircuitBreakerRegistry breakers_;
+    cache::ResultCache cache_;
+    cache::SingleFlight<Result<std::string>> inflight_;
     std::map<std::string, std::map<std::string, std::string>> schemas_;
-    std::unique_ptr<TCPTransport> transport_;
+    std::shared_ptr<TCPTransport> transport_;          // Owned, or borrowed from config_.connection
+    std::shared_ptr<TransportWatch> transport_watch_;  // Shared-runtime mode only
     std::atomic<bool> connected_{false};
     std::atomic<uint64_t> next_job_id_{1};
     std::mutex transport_mutex_;
     std::mutex jobs_mutex_;
     std::unordered_map<std::string, std::shared_ptr<LocalJobState>> jobs_;
+    std::mutex streams_mutex_;
+    std::unordered_map<std::string, std::shared_ptr<JobStream>> job_streams_;
+    std::vector<std::shared_ptr<JobStream>> finished_streams_;  // Pollers that completed but are not joined yet
+
+    // Metadata that only depends on InvokerConfig, pre-serialized as InvokeRequest wire bytes.
+    // Concatenated protobuf messages merge and the last map entry wins, so a request is laid out as
+    // [overridable headers][per-call fields][forced headers], matching per-call insertion order.
+    std::string overridable_headers_wire_;  // config_.headers and Authorization
+    std::string forced_headers_wire_;       // X-Game-ID and X-Env
 
     // Reconnection state
     std::atomic<bool> is_reconnecting_{false};
@@ -977,7 +1690,20 @@ class CroupierInvoker::Impl {
     std::thread reconnect_thread_;
     std::string last_error_;
 
-    explicit Impl(const InvokerConfig& config) : config_(config) {
+    // Shared-runtime mode: jobs, stream pollers and the pending reconnect run on config_.runtime
+    TaskGroup runtime_tasks_;
+    std::atomic<Runtime::SourceId> reconnect_timer_{0};
+
+    explicit Impl(const InvokerConfig& config)
+        : config_(config),
+          retry_budget_(config.retry_budget),
+          limiters_(config.concurrency_limit),
+          breakers_(config.circuit_breaker),
+          cache_(config.cache) {
+        if (config_.connection && !config_.runtime) {
+            config_.runtime = config_.connection->GetRuntime();
+        }
+
         // ========== Initialize Logger Configuration ==========
         auto& logger = Logger::GetInstance();
 
@@ -988,6 +1714,11 @@ class CroupierInvoker::Impl {
         } else {
             logger.SetLevelFromString(config_.log_level);
         }
+        logger.SetRateLimit(static_cast<uint32_t>(std::max(config_.log_rate_limit, 0)));
+        logger.SetTraceSampleRate(config_.log_trace_sample_rate);
+        if (config_.async_logging) {
+            logger.StartAsync();
+        }
 
         // Set default reconnect config
         reconnect_config_.enabled = true;
@@ -1011,6 +1742,72 @@ class CroupierInvoker::Impl {
                 retry_config_.retryable_status_codes = {14, 13, 2, 10, 4};  // Default codes
             }
         }
+
+        buildRequestTemplate();
+    }
+
+    ~Impl() { Close(); }
+
+    void buildRequestTemplate() {
+        croupier::sdk::v1::InvokeRequest overridable;
+        auto& headers = *overridable.mutable_metadata();
+        for (const auto& [key, value] : config_.headers) {
+            headers[key] = value;
+        }
+        if (!config_.auth_token.empty() && headers.find("Authorization") == headers.end()) {
+            headers["Authorization"] = "Bearer " + config_.auth_token;
+        }
+        overridable.SerializeToString(&overridable_headers_wire_);
+
+        croupier::sdk::v1::InvokeRequest forced;
+        if (!config_.game_id.empty()) {
+            (*forced.mutable_metadata())["X-Game-ID"] = config_.game_id;
+        }
+        if (!config_.env.empty()) {
+            (*forced.mutable_metadata())["X-Env"] = config_.env;
+        }
+        forced.SerializeToString(&forced_headers_wire_);
+    }
+
+    // Build the wire bytes of one InvokeRequest: only per-call fields are encoded here, on a
+    // stack-seeded arena; the static metadata is spliced in from the precomputed template.
+    // StartJob has never forwarded the routing options, so it passes with_routing = false.
+    std::vector<uint8_t> serializeInvokeRequest(const std::string& function_id, const std::string& payload,
+                                                const InvokeOptions& options, bool with_routing = true) const {
+        StackArena<kInvokeArenaBytes> arena;
+        auto* req = arena.Create<croupier::sdk::v1::InvokeRequest>();
+        req->set_function_id(function_id);
+        req->set_idempotency_key(options.idempotency_key.empty() ? utils::NewIdempotencyKey()
+                                                                 : options.idempotency_key);
+        req->set_payload(payload);
+
+        auto& metadata = *req->mutable_metadata();
+        for (const auto& [key, value] : options.metadata) {
+            metadata[key] = value;
+        }
+        if (with_routing) {
+            if (!options.route.empty()) {
+                metadata["route"] = options.route;
+            }
+            if (!options.target_service_id.empty()) {
+                metadata["target_service_id"] = options.target_service_id;
+            }
+            if (!options.hash_key.empty()) {
+                metadata["hash_key"] = options.hash_key;
+            }
+            if (!options.trace_id.empty()) {
+                metadata["trace_id"] = options.trace_id;
+            }
+        }
+
+        const size_t dynamic_size = req->ByteSizeLong();
+        std::vector<uint8_t> bytes(overridable_headers_wire_.size() + dynamic_size + forced_headers_wire_.size());
+        uint8_t* out = bytes.data();
+        std::memcpy(out, overridable_headers_wire_.data(), overridable_headers_wire_.size());
+        out += overridable_headers_wire_.size();
+        out = req->SerializeWithCachedSizesToArray(out);
+        std::memcpy(out, forced_headers_wire_.data(), forced_headers_wire_.size());
+        return bytes;
     }
 
     bool Connect() {
@@ -1027,7 +1824,7 @@ class CroupierInvoker::Impl {
             return true;
 
         SDK_LOG_INFO("Connecting to server/agent at: " << config_.address);
-        if (config_.address.empty()) {
+        if (config_.address.empty() && !config_.connection) {
             last_error_ = "connection address is empty";
             connected_ = false;
             return false;
@@ -1035,15 +1832,29 @@ class CroupierInvoker::Impl {
 
         last_error_.clear();
         connected_ = true;
-        std::cout << "✅ Connected to: " << config_.address << '\n';
+        SDK_LOG_INFO("✅ Connected to: " << config_.address);
         return true;
         try {
-            auto transport = std::make_unique<TCPTransport>(NormalizeTCPAddress(config_.address),
-                                                            config_.timeout_seconds * 1000);
-            transport->Connect();
+            std::shared_ptr<TCPTransport> transport;
+            std::shared_ptr<TransportWatch> watch;
+            if (config_.connection) {
+                transport = config_.connection->Acquire();
+            } else {
+                transport = std::make_shared<TCPTransport>(NormalizeTCPAddress(config_.address),
+                                                           config_.timeout_seconds * 1000);
+                transport->SetPolled(static_cast<bool>(config_.runtime));
+                transport->Connect();
+                if (config_.runtime) {
+                    watch = TransportWatch::Start(config_.runtime, *transport);
+                }
+            }
             {
                 std::lock_guard<std::mutex> lock(transport_mutex_);
+                if (transport_watch_) {
+                    transport_watch_->Stop();
+                }
                 transport_ = std::move(transport);
+                transport_watch_ = std::move(watch);
             }
             last_error_.clear();
             connected_ = true;
@@ -1058,124 +1869,86 @@ class CroupierInvoker::Impl {
     }
 
     std::string Invoke(const std::string& function_id, const std::string& payload, const InvokeOptions& options) {
+        return TryInvoke(function_id, payload, options).value();
+    }
+
+    Result<std::string> TryInvoke(const std::string& function_id, const std::string& payload,
+                                  const InvokeOptions& options) {
         if (!connected_ && !connectInternal()) {
             if (IsConnectionError()) {
                 ScheduleReconnectIfNeeded();
             }
-            throw std::runtime_error("Not connected to server");
+            return Error(StatusCode::UNAVAILABLE, "Not connected to server");
         }
 
         // Client-side validation
         auto it = schemas_.find(function_id);
         if (it != schemas_.end()) {
             if (!utils::ValidateJSON(payload, it->second)) {
-                throw std::runtime_error("Payload validation failed for function: " + function_id);
+                return Error(StatusCode::INVALID_ARGUMENT, "Payload validation failed for function: " + function_id);
             }
         }
 
-        // Get retry config (use options retry if provided, otherwise use config retry)
-        const RetryConfig& retry_config = options.retry.has_value() ? *options.retry : retry_config_;
+        auto invoke = [&]() {
+            InvokeOptions keyed_options;
+            const InvokeOptions& call_options = withIdempotencyKey(options, keyed_options);
+            return executeWithRetry("Invoke", function_id, call_options,
+                                    [&]() { return invokeInternal(function_id, payload, call_options); });
+        };
 
-        // If retry is disabled, execute directly
-        if (!retry_config.enabled) {
-            return invokeInternal(function_id, payload, options);
+        // Calls pinned to an explicit idempotency key are never merged with other callers
+        const bool coalesce = config_.coalesce_requests && options.idempotency_key.empty();
+        if (!cache_.Enabled() && !coalesce) {
+            return invoke();
         }
 
-        // Execute with retry
-        int max_attempts = retry_config.max_attempts;
-        std::string last_error;
-
-        for (int attempt = 0; attempt < max_attempts; ++attempt) {
-            try {
-                return invokeInternal(function_id, payload, options);
-            } catch (const std::exception& e) {
-                last_error = e.what();
-
-                // Check if this error is retryable and not the last attempt
-                if (attempt >= max_attempts - 1) {
-                    throw std::runtime_error("Invoke failed after " + std::to_string(max_attempts) +
-                                             " attempts: " + last_error);
-                }
-
-                // Check if error is retryable (simplified check)
-                bool is_retryable = last_error.find("UNAVAILABLE") != std::string::npos ||
-                                    last_error.find("INTERNAL") != std::string::npos ||
-                                    last_error.find("DEADLINE") != std::string::npos ||
-                                    last_error.find("connection") != std::string::npos ||
-                                    last_error.find("timeout") != std::string::npos;
-
-                if (!is_retryable) {
-                    throw std::runtime_error("Invoke failed with non-retryable error: " + last_error);
-                }
-
-                // Connection errors should trigger reconnection
-                if (IsConnectionError() && reconnect_config_.enabled) {
-                    connected_ = false;
-                    ScheduleReconnectIfNeeded();
-                }
+        // Serve repeated reads locally; any other operation of the same object invalidates them. The key covers
+        // the per-call metadata, so callers with different auth or player identity never share a result.
+        const std::string call_key = cache::ResultCache::MakeKey(function_id, options, payload);
+        uint64_t generation = 0;
+        if (auto cached = cache_.Get(function_id, call_key, &generation)) {
+            return std::move(*cached);
+        }
 
-                // Calculate delay and wait
-                int delay = CalculateRetryDelay(attempt);
-                std::cout << "Invocation attempt " << (attempt + 1) << " failed, retrying in " << delay
-                          << " ms: " << last_error << '\n';
-                std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        Result<std::string> result = coalesce ? inflight_.Do(call_key, invoke) : invoke();
+        if (cache_.Enabled()) {
+            if (result) {
+                cache_.Put(function_id, call_key, result.value(), generation);
             }
+            // Failed mutations may still have been applied, so invalidate either way
+            cache_.OnInvoked(function_id);
         }
-
-        throw std::runtime_error("Invoke failed after " + std::to_string(max_attempts) + " attempts: " + last_error);
+        return result;
     }
 
-    std::string invokeInternal(const std::string& function_id, const std::string& payload,
-                               const InvokeOptions& options) {
+    Result<std::string> invokeInternal(const std::string& function_id, const std::string& payload,
+                                       const InvokeOptions& options) {
 
-        (void)options;  // Suppress unused parameter warning
-        std::cout << "Invoking function: " << function_id << '\n';
+        SDK_LOG_TRACE(DEBUG, options.trace_id, "Invoking function: " << function_id);
         std::stringstream response;
         response << "{\"status\":\"success\",\"function_id\":\"" << EscapeJsonString(function_id)
                  << "\",\"payload\":" << (payload.empty() ? "null" : payload) << "}";
-        std::cout << "Response: " << response.str() << '\n';
+        SDK_LOG_TRACE(DEBUG, options.trace_id, "Response: " << response.str());
         return response.str();
-        croupier::sdk::v1::InvokeRequest req;
-        req.set_function_id(function_id);
-        req.set_idempotency_key(options.idempotency_key.empty() ? utils::NewIdempotencyKey() : options.idempotency_key);
-        req.set_payload(payload);
-
-        for (const auto& [key, value] : config_.headers) {
-            (*req.mutable_metadata())[key] = value;
-        }
-        for (const auto& [key, value] : options.metadata) {
-            (*req.mutable_metadata())[key] = value;
-        }
-        if (!config_.auth_token.empty() && req.metadata().find("Authorization") == req.metadata().end()) {
-            (*req.mutable_metadata())["Authorization"] = "Bearer " + config_.auth_token;
-        }
-        if (!config_.game_id.empty()) {
-            (*req.mutable_metadata())["X-Game-ID"] = config_.game_id;
-        }
-        if (!config_.env.empty()) {
-            (*req.mutable_metadata())["X-Env"] = config_.env;
-        }
-        if (!options.route.empty()) {
-            (*req.mutable_metadata())["route"] = options.route;
-        }
-        if (!options.target_service_id.empty()) {
-            (*req.mutable_metadata())["target_service_id"] = options.target_service_id;
-        }
-        if (!options.hash_key.empty()) {
-            (*req.mutable_metadata())["hash_key"] = options.hash_key;
-        }
-        if (!options.trace_id.empty()) {
-            (*req.mutable_metadata())["trace_id"] = options.trace_id;
-        }
+        const std::vector<uint8_t> request_bytes = serializeInvokeRequest(function_id, payload, options);
 
         std::lock_guard<std::mutex> lock(transport_mutex_);
         if (!transport_ || !transport_->IsConnected()) {
-            throw std::runtime_error("Not connected to server");
+            return Error(StatusCode::UNAVAILABLE, "Not connected to server");
         }
 
-        auto [_, response_body] = transport_->Call(protocol::MSG_INVOKE_REQUEST, SerializeMessage(req));
-        auto response = ParseMessage<croupier::sdk::v1::InvokeResponse>(response_body, "InvokeResponse");
-        return response.payload();
+        auto call = transport_->TryCall(protocol::MSG_INVOKE_REQUEST, request_bytes);
+        if (!call) {
+            return std::move(call).error();
+        }
+        StackArena<kInvokeArenaBytes> arena;
+        auto* invoke_response = arena.Create<croupier::sdk::v1::InvokeResponse>();
+        const auto& response_body = call.value().second;
+        if (!invoke_response->ParseFromArray(response_body.data(), static_cast<int>(response_body.size()))) {
+            return Error(StatusCode::INTERNAL,
+                         "failed to parse protobuf message: " + protocol::MsgIDString(protocol::MSG_INVOKE_RESPONSE));
+        }
+        return invoke_response->payload();
     }
 
     std::string StartJob(const std::string& function_id, const std::string& payload, const InvokeOptions& options) {
@@ -1194,169 +1967,151 @@ class CroupierInvoker::Impl {
             }
         }
 
-        // Get retry config (use options retry if provided, otherwise use config retry)
-        const RetryConfig& retry_config = options.retry.has_value() ? *options.retry : retry_config_;
-
-        // If retry is disabled, execute directly
-        if (!retry_config.enabled) {
-            return startJobInternal(function_id, payload, options);
-        }
-
-        // Execute with retry
-        int max_attempts = retry_config.max_attempts;
-        std::string last_error;
-
-        for (int attempt = 0; attempt < max_attempts; ++attempt) {
-            try {
-                return startJobInternal(function_id, payload, options);
-            } catch (const std::exception& e) {
-                last_error = e.what();
-
-                // Check if this error is retryable and not the last attempt
-                if (attempt >= max_attempts - 1) {
-                    throw std::runtime_error("StartJob failed after " + std::to_string(max_attempts) +
-                                             " attempts: " + last_error);
-                }
-
-                // Check if error is retryable (simplified check)
-                bool is_retryable = last_error.find("UNAVAILABLE") != std::string::npos ||
-                                    last_error.find("INTERNAL") != std::string::npos ||
-                                    last_error.find("DEADLINE") != std::string::npos ||
-                                    last_error.find("connection") != std::string::npos ||
-                                    last_error.find("timeout") != std::string::npos;
-
-                if (!is_retryable) {
-                    throw std::runtime_error("StartJob failed with non-retryable error: " + last_error);
-                }
-
-                // Connection errors should trigger reconnection
-                if (IsConnectionError() && reconnect_config_.enabled) {
-                    connected_ = false;
-                    ScheduleReconnectIfNeeded();
-                }
-
-                // Calculate delay and wait
-                int delay = CalculateRetryDelay(attempt);
-                std::cout << "StartJob attempt " << (attempt + 1) << " failed, retrying in " << delay
-                          << " ms: " << last_error << '\n';
-                std::this_thread::sleep_for(std::chrono::milliseconds(delay));
-            }
-        }
-
-        throw std::runtime_error("StartJob failed after " + std::to_string(max_attempts) + " attempts: " + last_error);
+        InvokeOptions keyed_options;
+        const InvokeOptions& call_options = withIdempotencyKey(options, keyed_options);
+        return executeWithRetry("StartJob", function_id, call_options,
+                                [&]() { return startJobInternal(function_id, payload, call_options); })
+            .value();
     }
 
-    std::string startJobInternal(const std::string& function_id, const std::string& payload,
-                                 const InvokeOptions& options) {
-
-        std::cout << "Starting job for function: " << function_id << '\n';
-        std::string job_id = "job-" + std::to_string(next_job_id_.fetch_add(1));
-        auto job = std::make_shared<LocalJobState>();
-        job->job_id = job_id;
-        job->function_id = function_id;
-        job->payload = payload;
-
-        {
-            std::lock_guard<std::mutex> lock(jobs_mutex_);
-            jobs_[job_id] = job;
+    // Every attempt of one call must carry the same idempotency key so the provider can
+    // deduplicate retries; storage receives the keyed copy when the caller did not set one.
+    static const InvokeOptions& withIdempotencyKey(const InvokeOptions& options, InvokeOptions& storage) {
+        if (!options.idempotency_key.empty()) {
+            return options;
         }
+        storage = options;
+        storage.idempotency_key = utils::NewIdempotencyKey();
+        return storage;
+    }
 
-        job->worker = std::thread([this, job, options]() {
-            if (job->cancelled) {
-                return;
-            }
+    static constexpr std::chrono::milliseconds kLocalJobStepDelay{10};
 
+    // Run one step of a local job: started, progress, then the invocation; false after the last
+    bool runLocalJobStep(const std::shared_ptr<LocalJobState>& job, const InvokeOptions& options, int step) {
+        if (step == 0) {
             JobEvent started;
             started.event_type = "started";
             started.job_id = job->job_id;
             started.payload = "{\"status\":\"started\"}";
             appendJobEvent(job, started);
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            if (job->cancelled) {
-                return;
-            }
-
+            return true;
+        }
+        if (step == 1) {
             JobEvent progress;
             progress.event_type = "progress";
             progress.job_id = job->job_id;
             progress.progress = 50;
             progress.payload = "{\"progress\":50}";
             appendJobEvent(job, progress);
+            return true;
+        }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        try {
+            const std::string result = invokeInternal(job->function_id, job->payload, options).value();
             if (job->cancelled) {
-                return;
+                return false;
             }
 
-            try {
-                const std::string result = invokeInternal(job->function_id, job->payload, options);
-                if (job->cancelled) {
-                    return;
-                }
+            JobEvent completed;
+            completed.event_type = "completed";
+            completed.job_id = job->job_id;
+            completed.payload = result;
+            completed.progress = 100;
+            completed.done = true;
+            appendJobEvent(job, completed);
+        } catch (const std::exception& e) {
+            JobEvent error;
+            error.event_type = "failed";
+            error.job_id = job->job_id;
+            error.error = e.what();
+            error.done = true;
+            appendJobEvent(job, error);
+        }
+        return false;
+    }
 
-                JobEvent completed;
-                completed.event_type = "completed";
-                completed.job_id = job->job_id;
-                completed.payload = result;
-                completed.progress = 100;
-                completed.done = true;
-                appendJobEvent(job, completed);
-            } catch (const std::exception& e) {
-                JobEvent error;
-                error.event_type = "failed";
-                error.job_id = job->job_id;
-                error.error = e.what();
-                error.done = true;
-                appendJobEvent(job, error);
+    // Shared-runtime mode: the pause before the next step is a runtime timer, so a job holds no
+    // pool worker while it waits. Close cancels the pending timer and waits for posted steps.
+    void postLocalJobStep(const std::shared_ptr<LocalJobState>& job, const InvokeOptions& options, int step) {
+        runtime_tasks_.Post(*config_.runtime, [this, job, options, step]() {
+            if (job->cancelled || !runLocalJobStep(job, options, step)) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            if (job->cancelled) {
+                return;
             }
+            job->step_timer = config_.runtime->ScheduleAfter(kLocalJobStepDelay, [this, job, options, step]() {
+                {
+                    std::lock_guard<std::mutex> timer_lock(jobs_mutex_);
+                    job->step_timer = 0;
+                }
+                postLocalJobStep(job, options, step + 1);
+            });
         });
+    }
 
-        std::cout << "Job started: " << job_id << '\n';
-        return job_id;
-        croupier::sdk::v1::InvokeRequest req;
-        req.set_function_id(function_id);
-        req.set_idempotency_key(options.idempotency_key.empty() ? utils::NewIdempotencyKey() : options.idempotency_key);
-        req.set_payload(payload);
+    Result<std::string> startJobInternal(const std::string& function_id, const std::string& payload,
+                                         const InvokeOptions& options) {
 
-        for (const auto& [key, value] : config_.headers) {
-            (*req.mutable_metadata())[key] = value;
-        }
-        for (const auto& [key, value] : options.metadata) {
-            (*req.mutable_metadata())[key] = value;
-        }
-        if (!config_.auth_token.empty() && req.metadata().find("Authorization") == req.metadata().end()) {
-            (*req.mutable_metadata())["Authorization"] = "Bearer " + config_.auth_token;
-        }
-        if (!config_.game_id.empty()) {
-            (*req.mutable_metadata())["X-Game-ID"] = config_.game_id;
+        SDK_LOG_TRACE(DEBUG, options.trace_id, "Starting job for function: " << function_id);
+        std::string job_id = "job-" + std::to_string(next_job_id_.fetch_add(1));
+        auto job = std::make_shared<LocalJobState>();
+        job->job_id = job_id;
+        job->function_id = function_id;
+        job->payload = payload;
+        job->runs_locally = true;
+
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            jobs_[job_id] = job;
         }
-        if (!config_.env.empty()) {
-            (*req.mutable_metadata())["X-Env"] = config_.env;
+
+        if (config_.runtime) {
+            postLocalJobStep(job, options, 0);
+        } else {
+            job->worker = std::thread([this, job, options]() {
+                for (int step = 0; !job->cancelled && runLocalJobStep(job, options, step); ++step) {
+                    std::this_thread::sleep_for(kLocalJobStepDelay);
+                }
+            });
         }
 
+        SDK_LOG_TRACE(DEBUG, options.trace_id, "Job started: " << job_id);
+        return job_id;
+        const std::vector<uint8_t> request_bytes = serializeInvokeRequest(function_id, payload, options, false);
+
         std::vector<uint8_t> response_body;
         {
             std::lock_guard<std::mutex> lock(transport_mutex_);
             if (!transport_ || !transport_->IsConnected()) {
-                throw std::runtime_error("Not connected to server");
+                return Error(StatusCode::UNAVAILABLE, "Not connected to server");
             }
-            auto response = transport_->Call(protocol::MSG_START_JOB_REQUEST, SerializeMessage(req));
-            response_body = std::move(response.second);
+            auto call = transport_->TryCall(protocol::MSG_START_JOB_REQUEST, request_bytes);
+            if (!call) {
+                return std::move(call).error();
+            }
+            response_body = std::move(call.value().second);
         }
 
-        auto response = ParseMessage<croupier::sdk::v1::StartJobResponse>(response_body, "StartJobResponse");
-        if (response.job_id().empty()) {
-            throw std::runtime_error("StartJob response did not include job ID");
+        StackArena<kInvokeArenaBytes> arena;
+        auto* response = arena.Create<croupier::sdk::v1::StartJobResponse>();
+        if (!response->ParseFromArray(response_body.data(), static_cast<int>(response_body.size()))) {
+            return Error(StatusCode::INTERNAL, "failed to parse protobuf message: " +
+                                                   protocol::MsgIDString(protocol::MSG_START_JOB_RESPONSE));
+        }
+        if (response->job_id().empty()) {
+            return Error(StatusCode::INTERNAL, "StartJob response did not include job ID");
         }
 
         auto state = std::make_shared<LocalJobState>();
-        state->job_id = response.job_id();
+        state->job_id = response->job_id();
         state->function_id = function_id;
         state->payload = payload;
         JobEvent started_event;
         started_event.event_type = "started";
-        started_event.job_id = response.job_id();
+        started_event.job_id = response->job_id();
         started_event.message = "Job started";
         started_event.progress = 0;
         started_event.done = false;
@@ -1366,121 +2121,188 @@ class CroupierInvoker::Impl {
             jobs_[state->job_id] = state;
         }
 
-        return response.job_id();
+        return state->job_id;
     }
 
     std::future<std::vector<JobEvent>> StreamJob(const std::string& job_id) {
-        return std::async(std::launch::async, [this, job_id]() {
-            if (!connected_ && !connectInternal()) {
-                if (IsConnectionError()) {
-                    ScheduleReconnectIfNeeded();
-                }
-                JobEvent error_event;
-                error_event.event_type = "error";
-                error_event.job_id = job_id;
-                error_event.error = "Not connected to server";
-                error_event.message = error_event.error;
-                error_event.done = true;
-                return std::vector<JobEvent>{error_event};
+        std::promise<std::vector<JobEvent>> subscriber;
+        auto future = subscriber.get_future();
+        if (subscribeToLocalJob(job_id, subscriber)) {
+            return future;
+        }
+
+        std::lock_guard<std::mutex> lock(streams_mutex_);
+        reapFinishedStreamsLocked();
+
+        auto& stream = job_streams_[job_id];
+        if (stream) {
+            stream->subscribers.push_back(std::move(subscriber));
+            return future;
+        }
+
+        auto created = std::make_shared<JobStream>();
+        created->subscribers.push_back(std::move(subscriber));
+        stream = created;
+        auto poll = [this, job_id, created]() {
+            std::vector<JobEvent> events = streamJobInternal(job_id);
+
+            std::vector<std::promise<std::vector<JobEvent>>> subscribers;
+            {
+                std::lock_guard<std::mutex> stream_lock(streams_mutex_);
+                subscribers.swap(created->subscribers);
+                job_streams_.erase(job_id);
+                finished_streams_.push_back(created);
+            }
+            for (auto& waiting : subscribers) {
+                waiting.set_value(events);
             }
+        };
+        if (config_.runtime) {
+            runtime_tasks_.Post(*config_.runtime, std::move(poll));
+        } else {
+            created->poller = std::thread(std::move(poll));
+        }
+        return future;
+    }
 
+    // A job run by this invoker needs no poller: its terminal event completes the subscriber
+    bool subscribeToLocalJob(const std::string& job_id, std::promise<std::vector<JobEvent>>& subscriber) {
+        std::unique_lock<std::mutex> lock(jobs_mutex_);
+        auto it = jobs_.find(job_id);
+        if (it == jobs_.end() || !it->second->runs_locally) {
+            return false;
+        }
+        LocalJobState& job = *it->second;
+        SDK_LOG_DEBUG("Subscribing to local job events for: " << job_id);
+        if (!job.done) {
+            job.subscribers.push_back(std::move(subscriber));
+            return true;
+        }
+        std::vector<JobEvent> events = job.events;
+        lock.unlock();
+        subscriber.set_value(std::move(events));
+        return true;
+    }
 
-            std::cout << "Streaming job events for: " << job_id << '\n';
-            auto job = findJob(job_id);
-            if (!job) {
-                JobEvent error_event;
-                error_event.event_type = "failed";
-                error_event.job_id = job_id;
-                error_event.error = "Job not found";
-                error_event.done = true;
-                return std::vector<JobEvent>{error_event};
+    // Join pollers that already delivered their events
+    void reapFinishedStreamsLocked() {
+        for (auto& finished : finished_streams_) {
+            if (finished->poller.joinable()) {
+                finished->poller.join();
             }
+        }
+        finished_streams_.clear();
+    }
 
-            while (!job->done) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::vector<JobEvent> streamJobInternal(const std::string& job_id) {
+        if (!connected_ && !connectInternal()) {
+            if (IsConnectionError()) {
+                ScheduleReconnectIfNeeded();
             }
+            JobEvent error_event;
+            error_event.event_type = "error";
+            error_event.job_id = job_id;
+            error_event.error = "Not connected to server";
+            error_event.message = error_event.error;
+            error_event.done = true;
+            return std::vector<JobEvent>{error_event};
+        }
+
+        SDK_LOG_DEBUG("Streaming job events for: " << job_id);
+        auto job = findJob(job_id);
+        if (!job) {
+            JobEvent error_event;
+            error_event.event_type = "failed";
+            error_event.job_id = job_id;
+            error_event.error = "Job not found";
+            error_event.done = true;
+            return std::vector<JobEvent>{error_event};
+        }
 
+        // Local jobs are normally subscribed to directly; wait the same way if one gets here
+        std::promise<std::vector<JobEvent>> subscriber;
+        auto finished = subscriber.get_future();
+        if (subscribeToLocalJob(job_id, subscriber)) {
+            return finished.get();
+        }
+        std::lock_guard<std::mutex> lock(jobs_mutex_);
+        return job->events;
+        std::vector<JobEvent> events;
+        {
             std::lock_guard<std::mutex> lock(jobs_mutex_);
-            return job->events;
-            std::vector<JobEvent> events;
-            {
-                std::lock_guard<std::mutex> lock(jobs_mutex_);
-                auto it = jobs_.find(job_id);
-                if (it != jobs_.end()) {
-                    events.insert(events.end(), it->second->events.begin(), it->second->events.end());
-                    if (!events.empty() && IsTerminalJobEvent(events.back())) {
-                        jobs_.erase(it);
-                        return events;
-                    }
+            auto it = jobs_.find(job_id);
+            if (it != jobs_.end()) {
+                events.insert(events.end(), it->second->events.begin(), it->second->events.end());
+                if (!events.empty() && IsTerminalJobEvent(events.back())) {
+                    jobs_.erase(it);
+                    return events;
                 }
             }
+        }
 
-            for (int attempt = 0; attempt < 120; ++attempt) {
-                croupier::sdk::v1::JobStreamRequest req;
-                req.set_job_id(job_id);
+        for (int attempt = 0; attempt < 120; ++attempt) {
+            croupier::sdk::v1::JobStreamRequest req;
+            req.set_job_id(job_id);
 
-                std::vector<uint8_t> response_body;
-                {
-                    std::lock_guard<std::mutex> lock(transport_mutex_);
-                    if (!transport_ || !transport_->IsConnected()) {
-                        JobEvent error_event;
-                        error_event.job_id = job_id;
-                        error_event.error = "Connection lost while streaming job";
-                        error_event.done = true;
-                        events.push_back(error_event);
-                        return events;
-                    }
-                    auto response = transport_->Call(protocol::MSG_STREAM_JOB_REQUEST, SerializeMessage(req));
-                    response_body = std::move(response.second);
+            croupier::sdk::v1::JobEvent proto_event;
+            {
+                std::lock_guard<std::mutex> lock(transport_mutex_);
+                if (!transport_ || !transport_->IsConnected()) {
+                    JobEvent error_event;
+                    error_event.job_id = job_id;
+                    error_event.error = "Connection lost while streaming job";
+                    error_event.done = true;
+                    events.push_back(error_event);
+                    return events;
                 }
+                proto_event = protocol::Call<protocol::MSG_STREAM_JOB_REQUEST>(*transport_, req);
+            }
 
-                auto proto_event = ParseMessage<croupier::sdk::v1::JobEvent>(response_body, "JobEvent");
-                JobEvent event = ToJobEvent(job_id, proto_event);
-                if (events.empty() || !SameJobEvent(events.back(), event)) {
-                    events.push_back(event);
-                }
+            JobEvent event = ToJobEvent(job_id, proto_event);
+            if (events.empty() || !SameJobEvent(events.back(), event)) {
+                events.push_back(event);
+            }
 
-                {
-                    std::lock_guard<std::mutex> lock(jobs_mutex_);
-                    auto& state = jobs_[job_id];
-                    if (!state) {
-                        state = std::make_shared<LocalJobState>();
-                        state->job_id = job_id;
-                    }
-                    state->events = events;
-                    if (IsTerminalJobEvent(event)) {
-                        state->done = true;
-                    }
+            {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                auto& state = jobs_[job_id];
+                if (!state) {
+                    state = std::make_shared<LocalJobState>();
+                    state->job_id = job_id;
                 }
-
+                state->events = events;
                 if (IsTerminalJobEvent(event)) {
-                    std::lock_guard<std::mutex> lock(jobs_mutex_);
-                    jobs_.erase(job_id);
-                    return events;
+                    state->done = true;
                 }
+            }
 
-                std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            if (IsTerminalJobEvent(event)) {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                jobs_.erase(job_id);
+                return events;
             }
 
-            JobEvent timeout_event;
-            timeout_event.event_type = "error";
-            timeout_event.job_id = job_id;
-            timeout_event.error = "Timed out waiting for job completion";
-            timeout_event.message = timeout_event.error;
-            timeout_event.done = true;
-            events.push_back(timeout_event);
-            return events;
-        });
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
+
+        JobEvent timeout_event;
+        timeout_event.event_type = "error";
+        timeout_event.job_id = job_id;
+        timeout_event.error = "Timed out waiting for job completion";
+        timeout_event.message = timeout_event.error;
+        timeout_event.done = true;
+        events.push_back(timeout_event);
+        return events;
     }
 
     bool CancelJob(const std::string& job_id) {
 
         if (job_id.empty()) {
-            std::cerr << "Job ID is required" << '\n';
+            SDK_LOG_ERROR("Job ID is required");
             return false;
         }
 
-        std::cout << "Cancelling job: " << job_id << '\n';
+        SDK_LOG_DEBUG("Cancelling job: " << job_id);
         auto job = findJob(job_id);
         if (!job || job->done) {
             return false;
@@ -1493,13 +2315,13 @@ class CroupierInvoker::Impl {
         cancelled.message = "Job cancelled";
         cancelled.done = true;
         appendJobEvent(job, cancelled);
-        std::cout << "Job cancellation sent: " << job_id << '\n';
+        SDK_LOG_DEBUG("Job cancellation sent: " << job_id);
         return true;
         if (!connected_ && !connectInternal()) {
             if (IsConnectionError()) {
                 ScheduleReconnectIfNeeded();
             }
-            std::cerr << "Not connected to server" << '\n';
+            SDK_LOG_ERROR("Not connected to server");
             return false;
         }
         croupier::sdk::v1::CancelJobRequest req;
@@ -1508,10 +2330,10 @@ class CroupierInvoker::Impl {
         {
             std::lock_guard<std::mutex> lock(transport_mutex_);
             if (!transport_ || !transport_->IsConnected()) {
-                std::cerr << "Not connected to server" << '\n';
+                SDK_LOG_ERROR("Not connected to server");
                 return false;
             }
-            transport_->Call(protocol::MSG_CANCEL_JOB_REQUEST, SerializeMessage(req));
+            protocol::Call<protocol::MSG_CANCEL_JOB_REQUEST>(*transport_, req);
         }
 
         std::lock_guard<std::mutex> lock(jobs_mutex_);
@@ -1531,9 +2353,11 @@ class CroupierInvoker::Impl {
 
     void SetSchema(const std::string& function_id, const std::map<std::string, std::string>& schema) {
         schemas_[function_id] = schema;
-        std::cout << "Set schema for function: " << function_id << '\n';
+        SDK_LOG_DEBUG("Set schema for function: " << function_id);
     }
 
+    void SetObjectDescriptor(const VirtualObjectDescriptor& desc) { cache_.RegisterObject(desc); }
+
     void SetReconnectConfig(const ReconnectConfig& config) { reconnect_config_ = config; }
 
     void SetRetryConfig(const RetryConfig& config) { retry_config_ = config; }
@@ -1544,6 +2368,7 @@ class CroupierInvoker::Impl {
         if (reconnect_thread_.joinable()) {
             reconnect_thread_.join();
         }
+        cancelReconnectTimer();
 
         std::vector<std::shared_ptr<LocalJobState>> jobs_to_close;
         {
@@ -1557,6 +2382,34 @@ class CroupierInvoker::Impl {
             if (job->worker.joinable()) {
                 job->worker.join();
             }
+            Runtime::SourceId step_timer = 0;
+            {
+                std::lock_guard<std::mutex> lock(jobs_mutex_);
+                step_timer = std::exchange(job->step_timer, 0);
+            }
+            if (step_timer != 0) {
+                config_.runtime->Cancel(step_timer);  // A step it already posted is waited for below
+            }
+        }
+
+        std::vector<std::shared_ptr<JobStream>> streams_to_close;
+        {
+            std::lock_guard<std::mutex> lock(streams_mutex_);
+            for (const auto& entry : job_streams_) {
+                streams_to_close.push_back(entry.second);
+            }
+            streams_to_close.insert(streams_to_close.end(), finished_streams_.begin(), finished_streams_.end());
+            finished_streams_.clear();
+        }
+        for (const auto& stream : streams_to_close) {
+            if (stream->poller.joinable()) {
+                stream->poller.join();
+            }
+        }
+        runtime_tasks_.Wait();
+        cancelReconnectTimer();  // A reconnect attempt that was running may have scheduled the next one
+        for (const auto& job : jobs_to_close) {
+            releaseJobSubscribers(job);
         }
         {
             std::lock_guard<std::mutex> lock(jobs_mutex_);
@@ -1566,10 +2419,14 @@ class CroupierInvoker::Impl {
         connected_ = false;
         {
             std::lock_guard<std::mutex> lock(transport_mutex_);
-            if (transport_) {
+            if (transport_watch_) {
+                transport_watch_->Stop();
+                transport_watch_.reset();
+            }
+            if (transport_ && !config_.connection) {
                 transport_->Close();
-                transport_.reset();
             }
+            transport_.reset();
         }
         {
             std::lock_guard<std::mutex> lock(jobs_mutex_);
@@ -1589,13 +2446,37 @@ class CroupierInvoker::Impl {
     }
 
     void appendJobEvent(const std::shared_ptr<LocalJobState>& job, const JobEvent& event) {
-        std::lock_guard<std::mutex> lock(jobs_mutex_);
-        if (job->done) {
-            return;
-        }
-        job->events.push_back(event);
-        if (event.done) {
+        std::vector<std::promise<std::vector<JobEvent>>> subscribers;
+        std::vector<JobEvent> events;
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            if (job->done) {
+                return;
+            }
+            job->events.push_back(event);
+            if (!event.done) {
+                return;
+            }
             job->done = true;
+            subscribers.swap(job->subscribers);
+            events = job->events;
+        }
+        for (auto& subscriber : subscribers) {
+            subscriber.set_value(events);
+        }
+    }
+
+    // Hand StreamJob callers the events so far when a job is abandoned without a terminal event
+    void releaseJobSubscribers(const std::shared_ptr<LocalJobState>& job) {
+        std::vector<std::promise<std::vector<JobEvent>>> subscribers;
+        std::vector<JobEvent> events;
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex_);
+            subscribers.swap(job->subscribers);
+            events = job->events;
+        }
+        for (auto& subscriber : subscribers) {
+            subscriber.set_value(events);
         }
     }
 
@@ -1650,8 +2531,7 @@ class CroupierInvoker::Impl {
 
         // Check max attempts
         if (reconnect_config_.max_attempts > 0 && reconnect_attempts_ >= reconnect_config_.max_attempts) {
-            std::cout << "Max reconnection attempts (" << reconnect_config_.max_attempts << ") reached, giving up"
-                      << '\n';
+            SDK_LOG_ERROR("Max reconnection attempts (" << reconnect_config_.max_attempts << ") reached, giving up");
             return;
         }
 
@@ -1659,7 +2539,15 @@ class CroupierInvoker::Impl {
         reconnect_attempts_++;
 
         int delay = CalculateReconnectDelay();
-        std::cout << "Scheduling reconnection attempt " << reconnect_attempts_ << " in " << delay << " ms" << '\n';
+        SDK_LOG_INFO("Scheduling reconnection attempt " << reconnect_attempts_ << " in " << delay << " ms");
+
+        if (config_.runtime) {
+            // The attempt runs as a tracked task so Close can wait for it
+            reconnect_timer_ = config_.runtime->ScheduleAfter(std::chrono::milliseconds(delay), [this]() {
+                runtime_tasks_.Post(*config_.runtime, [this]() { runReconnectAttempt(); });
+            });
+            return;
+        }
 
         // Stop existing reconnect thread if any
         if (reconnect_thread_.joinable()) {
@@ -1683,11 +2571,11 @@ class CroupierInvoker::Impl {
                 return;
             }
 
-            std::cout << "Reconnecting... (attempt " << reconnect_attempts_ << ")" << '\n';
+            SDK_LOG_INFO("Reconnecting... (attempt " << reconnect_attempts_ << ")");
             if (connectInternal()) {
-                std::cout << "Reconnection successful" << '\n';
+                SDK_LOG_INFO("Reconnection successful");
             } else {
-                std::cout << "Reconnection attempt " << reconnect_attempts_ << " failed" << '\n';
+                SDK_LOG_WARN("Reconnection attempt " << reconnect_attempts_ << " failed");
                 // Schedule next attempt (only if not stopping)
                 if (!should_stop_reconnecting_) {
                     ScheduleReconnectIfNeeded();
@@ -1696,16 +2584,157 @@ class CroupierInvoker::Impl {
         });
     }
 
+    void runReconnectAttempt() {
+        is_reconnecting_ = false;
+        if (should_stop_reconnecting_) {
+            return;
+        }
+        SDK_LOG_INFO("Reconnecting... (attempt " << reconnect_attempts_ << ")");
+        if (connectInternal()) {
+            SDK_LOG_INFO("Reconnection successful");
+        } else {
+            SDK_LOG_WARN("Reconnection attempt " << reconnect_attempts_ << " failed");
+            if (!should_stop_reconnecting_) {
+                ScheduleReconnectIfNeeded();
+            }
+        }
+    }
+
+    void cancelReconnectTimer() {
+        if (const Runtime::SourceId timer = reconnect_timer_.exchange(0)) {
+            config_.runtime->Cancel(timer);
+            is_reconnecting_ = false;
+        }
+    }
+
+    // Run one logical call with retry, guarded by the per-function circuit breaker, the
+    // invoker-wide retry budget and the per-target adaptive concurrency limit.
+    // Failures are returned as Error values; retryability is decided by status code.
+    template <typename Attempt>
+    Result<std::string> executeWithRetry(const std::string& operation, const std::string& function_id,
+                                         const InvokeOptions& options, Attempt&& attempt_fn) {
+        // Get retry config (use options retry if provided, otherwise use config retry)
+        const RetryConfig& retry_config = options.retry.has_value() ? *options.retry : retry_config_;
+        const std::string target = options.target_service_id.empty() ? config_.address : options.target_service_id;
+        auto limiter = limiters_.ForTarget(target);
+        auto breaker = breakers_.For(function_id, target);
+
+        // If retry is disabled, execute once and surface the original error
+        int max_attempts = retry_config.enabled ? retry_config.max_attempts : 1;
+        Error last_error;
+
+        for (int attempt = 0; attempt < max_attempts; ++attempt) {
+            if (limiter && !limiter->TryAcquire()) {
+                return Error(StatusCode::RESOURCE_EXHAUSTED,
+                             operation + " rejected: concurrency limit reached for target " + target);
+            }
+            // Fail fast while the function is known to be broken instead of waiting for the timeout
+            if (breaker && !breaker->AllowRequest()) {
+                if (limiter) {
+                    limiter->OnIgnored();
+                }
+                return Error(StatusCode::UNAVAILABLE,
+                             operation + " rejected: circuit open for " + function_id + " on " + target);
+            }
+
+            const auto started = std::chrono::steady_clock::now();
+            Result<std::string> result = runAttempt(attempt_fn);
+            if (result) {
+                const auto elapsed = std::chrono::steady_clock::now() - started;
+                if (limiter) {
+                    limiter->OnSuccess(elapsed);
+                }
+                if (breaker) {
+                    breaker->RecordSuccess(elapsed);
+                }
+                retry_budget_.RecordSuccess();
+                return result;
+            }
+
+            last_error = std::move(result).error();
+            const bool is_retryable = IsRetryableError(retry_config, last_error.code);
+            if (breaker) {
+                // Errors such as INVALID_ARGUMENT or NOT_FOUND are one caller's problem and mean the
+                // provider answered; counting them would open the circuit for every caller
+                if (is_retryable || IndicatesUnhealthyTarget(last_error.code)) {
+                    breaker->RecordFailure();
+                } else {
+                    breaker->RecordSuccess(std::chrono::steady_clock::now() - started);
+                }
+            }
+            if (limiter) {
+                if (is_retryable) {
+                    limiter->OnDropped();
+                } else {
+                    limiter->OnIgnored();
+                }
+            }
+
+            if (!retry_config.enabled) {
+                return last_error;
+            }
+
+            // Check if this error is retryable and not the last attempt
+            if (attempt >= max_attempts - 1) {
+                return Error(last_error.code, operation + " failed after " + std::to_string(max_attempts) +
+                                                  " attempts: " + last_error.message);
+            }
+
+            if (!is_retryable) {
+                return Error(last_error.code, operation + " failed with non-retryable error: " + last_error.message);
+            }
+
+            // Retries are capped at a fraction of recent successes to avoid retry storms
+            if (!retry_budget_.TryAcquireRetry()) {
+                return Error(last_error.code, operation + " failed, retry budget exhausted: " + last_error.message);
+            }
+
+            // Connection errors should trigger reconnection
+            if (last_error.code == StatusCode::UNAVAILABLE && reconnect_config_.enabled) {
+                connected_ = false;
+                ScheduleReconnectIfNeeded();
+            }
+
+            // Calculate delay and wait
+            int delay = CalculateRetryDelay(attempt);
+            SDK_LOG_WARN(operation << " attempt " << (attempt + 1) << " failed, retrying in " << delay
+                                   << " ms: " << last_error.message);
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        }
+
+        return Error(last_error.code, operation + " failed after " + std::to_string(max_attempts) +
+                                          " attempts: " + last_error.message);
+    }
+
+    // Exception boundary for attempts that still throw. Transport and protocol failures come back
+    // as typed Errors, so whatever escapes here is an application or local error: UNKNOWN, which
+    // the default retryable_status_codes retry; drop 2 from them to fail such errors at once.
+    template <typename Attempt>
+    static Result<std::string> runAttempt(Attempt& attempt_fn) {
+        try {
+            return attempt_fn();
+        } catch (const std::exception& e) {
+            return Error(StatusCode::UNKNOWN, e.what());
+        }
+    }
+
     // Check if error is retryable based on status code
-    bool IsRetryableError(int grpc_status_code) const {
-        for (int code : retry_config_.retryable_status_codes) {
-            if (code == grpc_status_code) {
+    static bool IsRetryableError(const RetryConfig& retry_config, StatusCode code) {
+        const int status_code = static_cast<int>(code);
+        for (int retryable : retry_config.retryable_status_codes) {
+            if (retryable == status_code) {
                 return true;
             }
         }
         return false;
     }
 
+    // Failures that say something about the provider or the path to it rather than the request
+    static bool IndicatesUnhealthyTarget(StatusCode code) {
+        return code == StatusCode::UNAVAILABLE || code == StatusCode::DEADLINE_EXCEEDED ||
+               code == StatusCode::INTERNAL;
+    }
+
     // Calculate retry delay with exponential backoff and jitter
     int CalculateRetryDelay(int attempt) const {
         // Calculate base delay using exponential backoff
@@ -1744,6 +2773,10 @@ bool CroupierClient::RegisterFunction(const FunctionDescriptor& desc, FunctionHa
     return impl_->RegisterFunction(desc, std::move(handler));
 }
 
+bool CroupierClient::RegisterFunction(const FunctionDescriptor& desc, FunctionViewHandler handler) {
+    return impl_->RegisterFunction(desc, std::move(handler));
+}
+
 // ========== Virtual Object Registration ==========
 bool CroupierClient::RegisterVirtualObject(const VirtualObjectDescriptor& desc,
                                            const std::map<std::string, FunctionHandler>& handlers) {
@@ -1801,6 +2834,38 @@ std::string CroupierClient::GetLocalAddress() const {
     return impl_->GetLocalAddress();
 }
 
+bool CroupierClient::UnregisterFunction(const std::string& function_id) {
+    return impl_->UnregisterFunction(function_id);
+}
+
+int CroupierClient::GetEventFd() const {
+    return impl_->GetEventFd();
+}
+
+int CroupierClient::NextTimeoutMs() const {
+    return impl_->NextTimeoutMs();
+}
+
+int CroupierClient::ProcessEvents() {
+    return impl_->ProcessEvents();
+}
+
+int CroupierClient::PollOnce(int timeout_ms) {
+    return impl_->PollOnce(timeout_ms);
+}
+
+std::vector<uint8_t> CroupierClient::HandleLocalRequest(uint32_t msg_type, const std::vector<uint8_t>& body) {
+    return impl_->HandleLocalRequest(msg_type, body);
+}
+
+uint64_t CroupierClient::GetCatalogHash() const {
+    return impl_->GetCatalogHash();
+}
+
+CacheStats CroupierClient::GetResponseCacheStats() const {
+    return impl_->GetResponseCacheStats();
+}
+
 // CroupierInvoker public interface
 CroupierInvoker::CroupierInvoker(const InvokerConfig& config) : impl_(std::make_unique<Impl>(config)) {}
 
@@ -1815,6 +2880,11 @@ std::string CroupierInvoker::Invoke(const std::string& function_id, const std::s
     return impl_->Invoke(function_id, payload, options);
 }
 
+Result<std::string> CroupierInvoker::TryInvoke(const std::string& function_id, const std::string& payload,
+                                              const InvokeOptions& options) {
+    return impl_->TryInvoke(function_id, payload, options);
+}
+
 std::string CroupierInvoker::StartJob(const std::string& function_id, const std::string& payload,
                                       const InvokeOptions& options) {
     return impl_->StartJob(function_id, payload, options);
@@ -1832,6 +2902,10 @@ void CroupierInvoker::SetSchema(const std::string& function_id, const std::map<s
     impl_->SetSchema(function_id, schema);
 }
 
+void CroupierInvoker::SetObjectDescriptor(const VirtualObjectDescriptor& desc) {
+    impl_->SetObjectDescriptor(desc);
+}
+
 void CroupierInvoker::SetReconnectConfig(const ReconnectConfig& config) {
     impl_->SetReconnectConfig(config);
 }
@@ -1959,11 +3033,11 @@ VirtualObjectDescriptor LoadObjectDescriptor(const std::string& file_path) {
         desc.name = json_simple.value("name", "Unnamed Object");
         desc.description = json_simple.value("description", "No description");
 
-        std::cout << "✅ Successfully loaded virtual object descriptor from: " << file_path << '\n';
+        SDK_LOG_INFO("✅ Successfully loaded virtual object descriptor from: " << file_path);
         return desc;
 
     } catch (const std::exception& e) {
-        std::cerr << "❌ Failed to load object descriptor from " << file_path << ": " << e.what() << '\n';
+        SDK_LOG_ERROR("❌ Failed to load object descriptor from " << file_path << ": " << e.what());
 
         // Return default descriptor on error
         desc.id = "error";
@@ -2053,11 +3127,11 @@ ComponentDescriptor LoadComponentDescriptor(const std::string& file_path) {
         desc.type = json_simple.value("type", "generic");
         desc.enabled = true;  // Default to enabled
 
-        std::cout << "✅ Successfully loaded component descriptor from: " << file_path << '\n';
+        SDK_LOG_INFO("✅ Successfully loaded component descriptor from: " << file_path);
         return desc;
 
     } catch (const std::exception& e) {
-        std::cerr << "❌ Failed to load component descriptor from " << file_path << ": " << e.what() << '\n';
+        SDK_LOG_ERROR("❌ Failed to load component descriptor from " << file_path << ": " << e.what());
 
         // Return default descriptor on error
         desc.id = "error";
@@ -2074,12 +3148,12 @@ ComponentDescriptor LoadComponentDescriptor(const std::string& file_path) {
 bool ValidateObjectDescriptor(const VirtualObjectDescriptor& desc) {
     // Basic validation
     if (desc.id.empty()) {
-        std::cerr << "Object descriptor validation failed: empty ID" << '\n';
+        SDK_LOG_ERROR("Object descriptor validation failed: empty ID");
         return false;
     }
 
     if (desc.version.empty()) {
-        std::cerr << "Object descriptor validation failed: empty version" << '\n';
+        SDK_LOG_ERROR("Object descriptor validation failed: empty version");
         return false;
     }
 
@@ -2087,7 +3161,7 @@ bool ValidateObjectDescriptor(const VirtualObjectDescriptor& desc) {
     // Validate operation mappings only if operations are defined
     for (const auto& op : desc.operations) {
         if (op.first.empty() || op.second.empty()) {
-            std::cerr << "Object descriptor validation failed: invalid operation mapping" << '\n';
+            SDK_LOG_ERROR("Object descriptor validation failed: invalid operation mapping");
             return false;
         }
     }
@@ -2095,14 +3169,14 @@ bool ValidateObjectDescriptor(const VirtualObjectDescriptor& desc) {
     // Validate relationships
     for (const auto& rel : desc.relationships) {
         if (rel.second.type.empty() || rel.second.entity.empty()) {
-            std::cerr << "Object descriptor validation failed: invalid relationship definition" << '\n';
+            SDK_LOG_ERROR("Object descriptor validation failed: invalid relationship definition");
             return false;
         }
 
         // Check relationship type
         const std::string& type = rel.second.type;
         if (type != "one-to-many" && type != "many-to-one" && type != "many-to-many" && type != "one-to-one") {
-            std::cerr << "Object descriptor validation failed: invalid relationship type: " << type << '\n';
+            SDK_LOG_ERROR("Object descriptor validation failed: invalid relationship type: " << type);
             return false;
         }
     }
@@ -2114,19 +3188,19 @@ bool ValidateObjectDescriptor(const VirtualObjectDescriptor& desc) {
 bool ValidateComponentDescriptor(const ComponentDescriptor& comp) {
     // Basic validation
     if (comp.id.empty()) {
-        std::cerr << "Component descriptor validation failed: empty ID" << '\n';
+        SDK_LOG_ERROR("Component descriptor validation failed: empty ID");
         return false;
     }
 
     if (comp.version.empty()) {
-        std::cerr << "Component descriptor validation failed: empty version" << '\n';
+        SDK_LOG_ERROR("Component descriptor validation failed: empty version");
         return false;
     }
 
     // Validate all entities
     for (const auto& entity : comp.entities) {
         if (!ValidateObjectDescriptor(entity)) {
-            std::cerr << "Component descriptor validation failed: invalid entity " << entity.id << '\n';
+            SDK_LOG_ERROR("Component descriptor validation failed: invalid entity " << entity.id);
             return false;
         }
     }
@@ -2134,7 +3208,7 @@ bool ValidateComponentDescriptor(const ComponentDescriptor& comp) {
     // Validate all functions
     for (const auto& func : comp.functions) {
         if (func.id.empty() || func.version.empty()) {
-            std::cerr << "Component descriptor validation failed: invalid function descriptor" << '\n';
+            SDK_LOG_ERROR("Component descriptor validation failed: invalid function descriptor");
             return false;
         }
     }
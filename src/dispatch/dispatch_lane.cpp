@@ -0,0 +1,109 @@
+#include "croupier/sdk/dispatch/dispatch_lane.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace croupier {
+namespace sdk {
+namespace dispatch {
+
+DispatchLane::DispatchLane(threading::Dispatcher& dispatcher, int max_per_frame)
+    : state_(std::make_shared<State>()) {
+    state_->dispatcher = &dispatcher;
+    state_->max_per_frame = max_per_frame > 0 ? static_cast<size_t>(max_per_frame) : 0;
+}
+
+std::string DispatchLane::Run(Work work, Clock::time_point deadline) {
+    if (state_->dispatcher->IsOwnerThread()) {
+        state_->executed.fetch_add(1, std::memory_order_relaxed);
+        return work();
+    }
+
+    auto invocation = std::make_shared<Invocation>();
+    invocation->work = std::move(work);
+    invocation->deadline = deadline;
+    auto result = invocation->result.get_future();
+
+    bool schedule = false;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->pending.push_back(invocation);
+        schedule = !std::exchange(state_->drain_queued, true);
+    }
+    if (schedule) {
+        auto state = state_;
+        state_->dispatcher->Enqueue([state]() { Drain(state); });
+    }
+
+    if (result.wait_until(deadline) != std::future_status::ready) {
+        int expected = QUEUED;
+        if (invocation->state.compare_exchange_strong(expected, ABANDONED)) {
+            state_->rejected.fetch_add(1, std::memory_order_relaxed);
+            throw std::runtime_error("handler did not start on its dispatcher before the deadline");
+        }
+    }
+    return result.get();
+}
+
+size_t DispatchLane::PendingCount() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->pending.size();
+}
+
+void DispatchLane::Drain(const std::shared_ptr<State>& state) {
+    std::vector<std::shared_ptr<Invocation>> batch;
+    bool more = false;
+    {
+        // Calls that arrive while a frame drains queue another drain into the same frame; the budget
+        // is shared by every drain of the frame, not granted to each
+        const uint64_t frame = state->dispatcher->GetFrameNumber();
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->frame != frame) {
+            state->frame = frame;
+            state->taken_in_frame = 0;
+        }
+        size_t count = state->pending.size();
+        if (state->max_per_frame > 0) {
+            count = std::min(count, state->max_per_frame - state->taken_in_frame);
+        }
+        state->taken_in_frame += count;
+        batch.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            batch.push_back(std::move(state->pending.front()));
+            state->pending.pop_front();
+        }
+        more = !state->pending.empty();
+        state->drain_queued = more;
+    }
+
+    for (const auto& invocation : batch) {
+        int expected = QUEUED;
+        if (!invocation->state.compare_exchange_strong(expected, RUNNING)) {
+            continue;  // The caller already gave up
+        }
+        if (Clock::now() >= invocation->deadline) {
+            state->rejected.fetch_add(1, std::memory_order_relaxed);
+            invocation->result.set_exception(std::make_exception_ptr(
+                std::runtime_error("handler did not start on its dispatcher before the deadline")));
+            continue;
+        }
+        try {
+            invocation->result.set_value(invocation->work());
+        } catch (...) {
+            invocation->result.set_exception(std::current_exception());
+        }
+        state->executed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Over budget: the rest waits for the next frame
+    if (more) {
+        state->dispatcher->EnqueueNextFrame([state]() { Drain(state); });
+    }
+}
+
+}  // namespace dispatch
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,132 @@
+#include "croupier/sdk/dispatch/function_table.h"
+
+#include "croupier/sdk/utils/hash.h"
+
+#include <algorithm>
+
+namespace croupier {
+namespace sdk {
+namespace dispatch {
+
+FunctionTable::FunctionTable(const std::map<std::string, FunctionHandler>& handlers,
+                             const std::map<std::string, FunctionViewHandler>& view_handlers,
+                             const std::map<std::string, FunctionDescriptor>& descriptors,
+                             const FunctionTable* previous) {
+    // Merge both sorted maps so a fresh table (and therefore its handles) is in function ID order
+    std::vector<Entry> live;
+    live.reserve(handlers.size() + view_handlers.size());
+    auto it = handlers.begin();
+    auto view_it = view_handlers.begin();
+    while (it != handlers.end() || view_it != view_handlers.end()) {
+        Entry entry;
+        if (view_it == view_handlers.end() || (it != handlers.end() && it->first < view_it->first)) {
+            entry.function_id = it->first;
+            entry.handler = it->second;
+            ++it;
+        } else {
+            if (it != handlers.end() && it->first == view_it->first) {
+                ++it;  // Zero-copy handler wins over a string handler with the same ID
+            }
+            entry.function_id = view_it->first;
+            entry.view_handler = view_it->second;
+            ++view_it;
+        }
+        auto desc = descriptors.find(entry.function_id);
+        if (desc != descriptors.end()) {
+            entry.cache_ttl_ms = desc->second.cache_ttl_ms;
+            entry.dispatcher = desc->second.dispatcher;
+            entry.dispatch_deadline_ms = desc->second.dispatch_deadline_ms;
+        }
+        entry.hash = Hash(entry.function_id);
+        live.push_back(std::move(entry));
+    }
+    live_count_ = live.size();
+
+    if (!previous) {
+        entries_ = std::move(live);
+    } else {
+        // Keep known IDs at their old handle, tombstone removed ones, append new ones. Entries are only
+        // moved out of live after the search, which relies on its ID order.
+        std::vector<size_t> matches;
+        matches.reserve(previous->entries_.size());
+        for (const Entry& old_entry : previous->entries_) {
+            auto match = std::lower_bound(live.begin(), live.end(), old_entry.function_id,
+                                          [](const Entry& e, const std::string& id) { return e.function_id < id; });
+            const bool found = match != live.end() && match->function_id == old_entry.function_id;
+            matches.push_back(found ? static_cast<size_t>(match - live.begin()) : live.size());
+        }
+
+        std::vector<bool> placed(live.size(), false);
+        entries_.reserve(previous->entries_.size() + live.size());
+        for (size_t i = 0; i < matches.size(); ++i) {
+            const Entry& old_entry = previous->entries_[i];
+            if (matches[i] < live.size()) {
+                placed[matches[i]] = true;
+                entries_.push_back(std::move(live[matches[i]]));
+            } else {
+                Entry tombstone;
+                tombstone.function_id = old_entry.function_id;
+                tombstone.hash = old_entry.hash;
+                entries_.push_back(std::move(tombstone));
+            }
+        }
+        for (size_t i = 0; i < live.size(); ++i) {
+            if (!placed[i]) {
+                entries_.push_back(std::move(live[i]));
+            }
+        }
+    }
+
+    size_t capacity = 8;
+    while (capacity < entries_.size() * 2) {
+        capacity <<= 1;
+    }
+    slots_.resize(capacity);
+    mask_ = capacity - 1;
+
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (!entries_[i].Live()) {
+            continue;
+        }
+        const uint64_t hash = entries_[i].hash;
+        uint64_t pos = hash & mask_;
+        while (slots_[pos].entry != 0) {
+            pos = (pos + 1) & mask_;
+        }
+        slots_[pos].tag = static_cast<uint32_t>(hash >> 32);
+        slots_[pos].entry = static_cast<uint32_t>(i + 1);
+    }
+}
+
+const FunctionTable::Entry* FunctionTable::Find(const std::string& function_id) const {
+    if (entries_.empty()) {
+        return nullptr;
+    }
+    const uint64_t hash = Hash(function_id);
+    const uint32_t tag = static_cast<uint32_t>(hash >> 32);
+    for (uint64_t pos = hash & mask_;; pos = (pos + 1) & mask_) {
+        const Slot& slot = slots_[pos];
+        if (slot.entry == 0) {
+            return nullptr;
+        }
+        if (slot.tag == tag) {
+            const Entry& entry = entries_[slot.entry - 1];
+            if (entry.hash == hash && entry.function_id == function_id) {
+                return &entry;
+            }
+        }
+    }
+}
+
+uint32_t FunctionTable::HandleOf(const std::string& function_id) const {
+    const Entry* entry = Find(function_id);
+    return entry ? static_cast<uint32_t>(entry - entries_.data() + 1) : 0;
+}
+
+uint64_t FunctionTable::Hash(const std::string& function_id) {
+    return utils::Fnv1a(function_id);
+}
+
+}  // namespace dispatch
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,424 @@
+#include "croupier/sdk/logger.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+namespace croupier {
+namespace sdk {
+
+namespace {
+
+constexpr size_t kMaxBatchBytes = 64 * 1024;
+
+const char* LevelName(Logger::Level level) {
+    switch (level) {
+    case Logger::Level::DEBUG:
+        return "DEBUG";
+    case Logger::Level::INFO:
+        return "INFO";
+    case Logger::Level::WARN:
+        return "WARN";
+    case Logger::Level::ERR:
+        return "ERROR";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+// Append "2025-01-02T03:04:05.678Z". The part up to the seconds is formatted once per second per thread.
+void AppendTimestamp(std::string& out) {
+    struct SecondCache {
+        std::time_t second = -1;
+        char text[32] = {};
+        size_t length = 0;
+    };
+    thread_local SecondCache cache;
+
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t second = std::chrono::system_clock::to_time_t(now);
+    if (second != cache.second) {
+        std::tm tm{};
+#ifdef _WIN32
+        gmtime_s(&tm, &second);
+#else
+        gmtime_r(&second, &tm);
+#endif
+        cache.length = std::strftime(cache.text, sizeof(cache.text), "%Y-%m-%dT%H:%M:%S", &tm);
+        cache.second = second;
+    }
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+    out.append(cache.text, cache.length);
+    const char millis[6] = {'.', char('0' + ms / 100), char('0' + ms / 10 % 10), char('0' + ms % 10), 'Z', ' '};
+    out.append(millis, sizeof(millis));
+}
+
+// Index of the quote closing the string whose body starts at pos, or npos if unterminated
+size_t FindStringEnd(const std::string& json, size_t pos) {
+    while (pos < json.size()) {
+        const char c = json[pos];
+        if (c == '"') {
+            return pos;
+        }
+        pos += c == '\\' ? 2 : 1;
+    }
+    return std::string::npos;
+}
+
+size_t SkipSpace(const std::string& json, size_t pos) {
+    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' || json[pos] == '\n' || json[pos] == '\r')) {
+        pos++;
+    }
+    return pos;
+}
+
+}  // namespace
+
+JsonMasker::JsonMasker(const std::vector<std::string>& keys_to_mask) {
+    size_t size = 0;
+    for (const auto& key : keys_to_mask) {
+        if (!key.empty()) {
+            size++;
+        }
+    }
+    if (size == 0) {
+        return;
+    }
+
+    size_t capacity = 4;
+    while (capacity < size * 2) {
+        capacity <<= 1;
+    }
+    slots_.resize(capacity);
+    min_key_size_ = std::string::npos;
+    for (const auto& key : keys_to_mask) {
+        if (key.empty()) {
+            continue;
+        }
+        const uint64_t hash = utils::Fnv1a(key);
+        size_t index = hash & (capacity - 1);
+        while (!slots_[index].key.empty() && slots_[index].key != key) {
+            index = (index + 1) & (capacity - 1);
+        }
+        slots_[index].hash = hash;
+        slots_[index].key = key;
+        min_key_size_ = std::min(min_key_size_, key.size());
+        max_key_size_ = std::max(max_key_size_, key.size());
+    }
+}
+
+bool JsonMasker::isMasked(const char* key, size_t size) const {
+    if (slots_.empty() || size < min_key_size_ || size > max_key_size_) {
+        return false;
+    }
+    const uint64_t hash = utils::Fnv1a(key, size);
+    const size_t mask = slots_.size() - 1;
+    for (size_t index = hash & mask; !slots_[index].key.empty(); index = (index + 1) & mask) {
+        const Slot& slot = slots_[index];
+        if (slot.hash == hash && slot.key.size() == size && std::memcmp(slot.key.data(), key, size) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string JsonMasker::Mask(const std::string& json) const {
+    std::string out;
+    MaskInto(json, out);
+    return out;
+}
+
+void JsonMasker::MaskInto(const std::string& json, std::string& out) const {
+    if (slots_.empty()) {
+        out += json;
+        return;
+    }
+    out.reserve(out.size() + json.size());
+
+    // Every string token is skipped whole, so quotes and colons inside values are never
+    // mistaken for keys. A string followed by ':' is a key.
+    size_t copied = 0;
+    size_t pos = json.find('"');
+    while (pos != std::string::npos) {
+        const size_t key_end = FindStringEnd(json, pos + 1);
+        if (key_end == std::string::npos) {
+            break;
+        }
+        size_t next = key_end + 1;
+        const size_t colon = SkipSpace(json, next);
+        if (colon < json.size() && json[colon] == ':' && isMasked(json.data() + pos + 1, key_end - pos - 1)) {
+            const size_t value = SkipSpace(json, colon + 1);
+            if (value < json.size() && json[value] == '"') {
+                const size_t value_end = FindStringEnd(json, value + 1);
+                if (value_end != std::string::npos && value_end > value + 1) {
+                    out.append(json, copied, pos - copied);
+                    out.append(json, pos, key_end - pos + 1);
+                    out += ":\"***masked***\"";
+                    copied = value_end + 1;
+                }
+                next = value_end == std::string::npos ? json.size() : value_end + 1;
+            }
+        }
+        pos = json.find('"', next);
+    }
+    out.append(json, copied, std::string::npos);
+}
+
+// Bounded MPSC ring of formatted lines (Vyukov's sequence-numbered slots). Producers swap their
+// buffer into a slot and get the slot's old, cleared buffer back, so steady-state logging does
+// not allocate.
+class Logger::AsyncQueue {
+public:
+    explicit AsyncQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots_.reset(new Slot[size]);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Takes line on success and leaves an empty buffer in its place
+    bool TryPush(std::string& line) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.line.swap(line);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer only: append the oldest line to out
+    bool TryPopInto(std::string& out) {
+        Slot& slot = slots_[dequeue_pos_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+            return false;
+        }
+        out.append(slot.line);
+        slot.line.clear();
+        slot.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        dequeue_pos_++;
+        return true;
+    }
+
+    size_t Enqueued() const { return enqueue_pos_.load(std::memory_order_acquire); }
+
+    std::mutex mutex;  // Guards the fields below
+    std::condition_variable wake_writer;
+    std::condition_variable written_cv;
+    bool stopping = false;
+    size_t written = 0;  // Lines handed to the sink
+    std::chrono::milliseconds flush_interval{50};
+    std::atomic<bool> writer_idle{false};
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        std::string line;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_ = 0;
+    std::atomic<size_t> enqueue_pos_{0};
+    size_t dequeue_pos_ = 0;
+};
+
+Logger::Logger() {
+#ifdef CROUPIER_USE_SPDLOG
+    try {
+        spdlog_logger_ = spdlog::stdout_color_mt("croupier");
+        spdlog_logger_->set_level(spdlog::level::info);
+        spdlog_logger_->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [%n] %v");
+    } catch (const spdlog::spdlog_ex& ex) {
+        std::cerr << "Failed to initialize spdlog: " << ex.what() << std::endl;
+    }
+#endif
+}
+
+Logger::~Logger() {
+    StopAsync();
+}
+
+void Logger::Log(Level level, const std::string& component, const std::string& message) {
+    if (!IsEnabled(level)) {
+        return;
+    }
+
+#ifdef CROUPIER_USE_SPDLOG
+    if (spdlog_logger_) {
+        switch (level) {
+        case Level::DEBUG:
+            spdlog_logger_->debug("[{}] {}", component, message);
+            break;
+        case Level::INFO:
+            spdlog_logger_->info("[{}] {}", component, message);
+            break;
+        case Level::WARN:
+            spdlog_logger_->warn("[{}] {}", component, message);
+            break;
+        case Level::ERR:
+            spdlog_logger_->error("[{}] {}", component, message);
+            break;
+        default:
+            break;
+        }
+        return;
+    }
+#endif
+
+    thread_local std::string line;
+    line.clear();
+    AppendTimestamp(line);
+    line += '[';
+    line += LevelName(level);
+    line += "] [";
+    line += component;
+    line += "] ";
+    line += message;
+    line += '\n';
+
+    // StopAsync clears async_active_ and then waits for pushing_ to drain, so a caller that
+    // sees async mode here can use queue_ until it decrements pushing_
+    pushing_.fetch_add(1);
+    if (!async_active_.load()) {
+        pushing_.fetch_sub(1);
+        write(line.data(), line.size());
+        return;
+    }
+
+    AsyncQueue& queue = *queue_;
+    while (!queue.TryPush(line)) {
+        if (overflow_.load(std::memory_order_relaxed) == LogOverflow::DROP) {
+            dropped_total_.fetch_add(1, std::memory_order_relaxed);
+            dropped_unreported_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        queue.wake_writer.notify_one();
+        std::this_thread::yield();
+    }
+    // A push that just misses the writer going idle waits at most flush_interval
+    if (queue.writer_idle.load(std::memory_order_relaxed)) {
+        queue.wake_writer.notify_one();
+    }
+    pushing_.fetch_sub(1);
+}
+
+void Logger::SetSink(Sink sink) {
+    std::lock_guard<std::mutex> lock(sink_mutex_);
+    sink_ = std::move(sink);
+}
+
+void Logger::StartAsync(const AsyncLogConfig& config) {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    overflow_.store(config.overflow, std::memory_order_relaxed);
+    if (!writer_.joinable()) {
+        queue_ = std::make_shared<AsyncQueue>(config.queue_capacity);
+    }
+    {
+        std::lock_guard<std::mutex> queue_lock(queue_->mutex);
+        queue_->flush_interval = std::max(config.flush_interval, std::chrono::milliseconds(1));
+        queue_->stopping = false;
+    }
+    if (!writer_.joinable()) {
+        writer_ = std::thread([this]() { writerLoop(); });
+    }
+    async_active_.store(true, std::memory_order_release);
+}
+
+void Logger::StopAsync() {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    if (!writer_.joinable()) {
+        return;
+    }
+    // New callers write directly; the writer keeps making room until the ones already pushing finish
+    async_active_.store(false);
+    while (pushing_.load() != 0) {
+        std::this_thread::yield();
+    }
+    {
+        std::lock_guard<std::mutex> queue_lock(queue_->mutex);
+        queue_->stopping = true;
+    }
+    queue_->wake_writer.notify_one();
+    writer_.join();
+}
+
+void Logger::Flush() {
+    // The copy keeps the queue alive if StopAsync and StartAsync replace it while this call waits
+    std::shared_ptr<AsyncQueue> queue;
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        if (!writer_.joinable()) {
+            return;
+        }
+        queue = queue_;
+    }
+    const size_t target = queue->Enqueued();
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    queue->wake_writer.notify_one();
+    queue->written_cv.wait(lock, [&]() { return queue->written >= target || queue->stopping; });
+}
+
+void Logger::write(const char* data, size_t size) {
+    std::lock_guard<std::mutex> lock(sink_mutex_);
+    if (sink_) {
+        sink_(data, size);
+        return;
+    }
+    std::cout.write(data, static_cast<std::streamsize>(size));
+    std::cout.flush();
+}
+
+void Logger::writerLoop() {
+    AsyncQueue& queue = *queue_;
+    std::string batch;
+    for (;;) {
+        batch.clear();
+        size_t lines = 0;
+        while (batch.size() < kMaxBatchBytes && queue.TryPopInto(batch)) {
+            lines++;
+        }
+        if (const uint64_t dropped = dropped_unreported_.exchange(0, std::memory_order_relaxed)) {
+            std::string notice;
+            AppendTimestamp(notice);
+            notice += "[WARN] [logger] dropped " + std::to_string(dropped) + " log records: async queue full\n";
+            batch += notice;
+        }
+        if (!batch.empty()) {
+            write(batch.data(), batch.size());
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.written += lines;
+            queue.written_cv.notify_all();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(queue.mutex);
+        if (queue.stopping) {
+            queue.written_cv.notify_all();
+            return;
+        }
+        queue.writer_idle.store(true, std::memory_order_relaxed);
+        queue.wake_writer.wait_for(lock, queue.flush_interval);
+        queue.writer_idle.store(false, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,89 @@
+#include "croupier/sdk/registry/function_catalog.h"
+
+#include "croupier/sdk/utils/hash.h"
+
+namespace croupier {
+namespace sdk {
+namespace registry {
+
+namespace {
+
+void Mix(uint64_t& hash, uint64_t value) {
+    hash = utils::Fnv1a(value, hash);
+}
+
+// FNV-1a over a length-prefixed field, so ("ab", "c") and ("a", "bc") hash differently
+void Mix(uint64_t& hash, const std::string& field) {
+    Mix(hash, static_cast<uint64_t>(field.size()));
+    hash = utils::Fnv1a(field, hash);
+}
+
+}  // namespace
+
+uint64_t FunctionCatalog::Fingerprint(const FunctionDescriptor& desc) {
+    uint64_t hash = utils::kFnv1aOffset;
+    Mix(hash, desc.id);
+    Mix(hash, desc.version);
+    Mix(hash, static_cast<uint64_t>(desc.tags.size()));
+    for (const auto& tag : desc.tags) {
+        Mix(hash, tag);
+    }
+    Mix(hash, desc.summary);
+    Mix(hash, desc.description);
+    Mix(hash, desc.operation_id);
+    Mix(hash, static_cast<uint64_t>(desc.deprecated));
+    Mix(hash, desc.input_schema);
+    Mix(hash, desc.output_schema);
+    Mix(hash, desc.category);
+    Mix(hash, desc.risk);
+    Mix(hash, desc.entity);
+    Mix(hash, desc.operation);
+    return hash;
+}
+
+void FunctionCatalog::Set(const FunctionDescriptor& desc) {
+    fingerprints_[desc.id] = Fingerprint(desc);
+}
+
+void FunctionCatalog::Remove(const std::string& function_id) {
+    fingerprints_.erase(function_id);
+}
+
+void FunctionCatalog::Clear() {
+    fingerprints_.clear();
+}
+
+uint64_t FunctionCatalog::Hash() const {
+    uint64_t hash = utils::kFnv1aOffset;
+    for (const auto& [function_id, fingerprint] : fingerprints_) {
+        Mix(hash, function_id);
+        Mix(hash, fingerprint);
+    }
+    return hash;
+}
+
+CatalogDelta FunctionCatalog::Diff(const FunctionCatalog& base) const {
+    CatalogDelta delta;
+    auto it = fingerprints_.begin();
+    auto base_it = base.fingerprints_.begin();
+    while (it != fingerprints_.end() || base_it != base.fingerprints_.end()) {
+        if (base_it == base.fingerprints_.end() || (it != fingerprints_.end() && it->first < base_it->first)) {
+            delta.added.push_back(it->first);
+            ++it;
+        } else if (it == fingerprints_.end() || base_it->first < it->first) {
+            delta.removed.push_back(base_it->first);
+            ++base_it;
+        } else {
+            if (it->second != base_it->second) {
+                delta.changed.push_back(it->first);
+            }
+            ++it;
+            ++base_it;
+        }
+    }
+    return delta;
+}
+
+}  // namespace registry
+}  // namespace sdk
+}  // namespace croupier
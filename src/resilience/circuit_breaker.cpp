@@ -0,0 +1,163 @@
+#include "croupier/sdk/resilience/circuit_breaker.h"
+
+#include <algorithm>
+
+namespace croupier {
+namespace sdk {
+namespace resilience {
+
+CircuitBreaker::CircuitBreaker(const CircuitBreakerConfig& config) : config_(config) {
+    config_.window_seconds = std::max(1, config_.window_seconds);
+    config_.minimum_requests = std::max(1, config_.minimum_requests);
+    config_.half_open_max_probes = std::max(1, config_.half_open_max_probes);
+    config_.open_duration_ms = std::max(0, config_.open_duration_ms);
+    buckets_.resize(static_cast<size_t>(config_.window_seconds));
+}
+
+bool CircuitBreaker::AllowRequest(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    refreshLocked(now);
+
+    switch (state_) {
+    case State::CLOSED:
+        return true;
+    case State::OPEN:
+        return false;
+    case State::HALF_OPEN:
+        if (probes_in_flight_ >= config_.half_open_max_probes) {
+            return false;
+        }
+        probes_in_flight_++;
+        return true;
+    }
+    return false;
+}
+
+void CircuitBreaker::RecordSuccess(Clock::duration latency, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ == State::HALF_OPEN) {
+        probes_in_flight_ = std::max(0, probes_in_flight_ - 1);
+        if (++probe_successes_ >= config_.half_open_max_probes) {
+            transitionLocked(State::CLOSED, now);
+        }
+        return;
+    }
+    if (state_ == State::OPEN) {
+        return;
+    }
+
+    Bucket& bucket = currentBucket(now);
+    bucket.calls++;
+    if (config_.slow_call_threshold_ms > 0 &&
+        latency >= std::chrono::milliseconds(config_.slow_call_threshold_ms)) {
+        bucket.slow++;
+    }
+    evaluateLocked(now);
+}
+
+void CircuitBreaker::RecordFailure(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (state_ == State::HALF_OPEN) {
+        transitionLocked(State::OPEN, now);
+        return;
+    }
+    if (state_ == State::OPEN) {
+        return;
+    }
+
+    Bucket& bucket = currentBucket(now);
+    bucket.calls++;
+    bucket.failures++;
+    evaluateLocked(now);
+}
+
+CircuitBreaker::State CircuitBreaker::GetState(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    refreshLocked(now);
+    return state_;
+}
+
+CircuitBreaker::Bucket& CircuitBreaker::currentBucket(Clock::time_point now) {
+    const int64_t second = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+    Bucket& bucket = buckets_[static_cast<size_t>(second % static_cast<int64_t>(buckets_.size()))];
+    if (bucket.second != second) {
+        bucket = Bucket{};
+        bucket.second = second;
+    }
+    return bucket;
+}
+
+void CircuitBreaker::evaluateLocked(Clock::time_point now) {
+    const int64_t second = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+    const int64_t window = static_cast<int64_t>(buckets_.size());
+
+    int64_t calls = 0;
+    int64_t failures = 0;
+    int64_t slow = 0;
+    for (const auto& bucket : buckets_) {
+        if (bucket.second >= 0 && bucket.second > second - window && bucket.second <= second) {
+            calls += bucket.calls;
+            failures += bucket.failures;
+            slow += bucket.slow;
+        }
+    }
+
+    if (calls < config_.minimum_requests) {
+        return;
+    }
+
+    const double failure_rate = static_cast<double>(failures) / static_cast<double>(calls);
+    const double slow_rate = static_cast<double>(slow) / static_cast<double>(calls);
+    if (failure_rate >= config_.failure_rate_threshold ||
+        (config_.slow_call_threshold_ms > 0 && slow_rate >= config_.slow_call_rate_threshold)) {
+        transitionLocked(State::OPEN, now);
+    }
+}
+
+void CircuitBreaker::transitionLocked(State state, Clock::time_point now) {
+    state_ = state;
+    probes_in_flight_ = 0;
+    probe_successes_ = 0;
+    if (state == State::OPEN) {
+        opened_at_ = now;
+    }
+    if (state == State::CLOSED) {
+        // Start from a clean window so the failures that opened the circuit do not trip it again.
+        std::fill(buckets_.begin(), buckets_.end(), Bucket{});
+    }
+}
+
+void CircuitBreaker::refreshLocked(Clock::time_point now) {
+    if (state_ == State::OPEN && now - opened_at_ >= std::chrono::milliseconds(config_.open_duration_ms)) {
+        transitionLocked(State::HALF_OPEN, now);
+    }
+}
+
+std::shared_ptr<CircuitBreaker> CircuitBreakerRegistry::For(const std::string& function_id,
+                                                            const std::string& target) {
+    if (!config_.enabled) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& breaker = breakers_[function_id + "@" + target];
+    if (!breaker) {
+        breaker = std::make_shared<CircuitBreaker>(config_);
+    }
+    return breaker;
+}
+
+std::string CircuitStateToString(CircuitBreaker::State state) {
+    switch (state) {
+    case CircuitBreaker::State::CLOSED:
+        return "CLOSED";
+    case CircuitBreaker::State::OPEN:
+        return "OPEN";
+    case CircuitBreaker::State::HALF_OPEN:
+        return "HALF_OPEN";
+    }
+    return "UNKNOWN";
+}
+
+}  // namespace resilience
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,122 @@
+#include "croupier/sdk/resilience/concurrency_limiter.h"
+
+#include <algorithm>
+
+namespace croupier {
+namespace sdk {
+namespace resilience {
+
+namespace {
+// Weight of each sample in the long-window RTT average (roughly the last 50 samples).
+constexpr double kLongRttSmoothing = 0.02;
+}  // namespace
+
+AdaptiveConcurrencyLimiter::AdaptiveConcurrencyLimiter(const ConcurrencyLimitConfig& config) : config_(config) {
+    config_.min_limit = std::max(1, config_.min_limit);
+    config_.max_limit = std::max(config_.min_limit, config_.max_limit);
+    config_.backoff_ratio = std::clamp(config_.backoff_ratio, 0.1, 1.0);
+    config_.latency_tolerance = std::max(1.0, config_.latency_tolerance);
+    limit_ = static_cast<double>(std::clamp(config_.initial_limit, config_.min_limit, config_.max_limit));
+}
+
+bool AdaptiveConcurrencyLimiter::TryAcquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (in_flight_ >= static_cast<int>(limit_)) {
+        return false;
+    }
+    in_flight_++;
+    return true;
+}
+
+void AdaptiveConcurrencyLimiter::OnSuccess(Clock::duration rtt) {
+    const double rtt_us =
+        std::max(1.0, static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(rtt).count()));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int in_flight = in_flight_;
+    releaseLocked();
+    const bool cooling_down = startSampleLocked();
+
+    if (long_rtt_us_ <= 0.0) {
+        long_rtt_us_ = rtt_us;
+        return;
+    }
+
+    // Compare against the long-window average of all samples, then fold the sample in. A lasting
+    // latency shift therefore moves the average until it is the new normal instead of being
+    // treated as congestion forever.
+    const bool inflated = rtt_us > long_rtt_us_ * config_.latency_tolerance;
+    long_rtt_us_ = long_rtt_us_ * (1.0 - kLongRttSmoothing) + rtt_us * kLongRttSmoothing;
+
+    if (inflated) {
+        decreaseLocked(cooling_down);
+        return;
+    }
+
+    // Only grow while the current limit is actually being used; otherwise an idle target would
+    // drift to max_limit and offer no protection when the next burst arrives.
+    if (in_flight * 2 >= static_cast<int>(limit_)) {
+        limit_ = std::min(static_cast<double>(config_.max_limit), limit_ + 1.0 / limit_);
+    }
+}
+
+void AdaptiveConcurrencyLimiter::OnDropped() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    releaseLocked();
+    decreaseLocked(startSampleLocked());
+}
+
+void AdaptiveConcurrencyLimiter::OnIgnored() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    releaseLocked();
+}
+
+int AdaptiveConcurrencyLimiter::GetLimit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(limit_);
+}
+
+int AdaptiveConcurrencyLimiter::GetInFlight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+void AdaptiveConcurrencyLimiter::releaseLocked() {
+    if (in_flight_ > 0) {
+        in_flight_--;
+    }
+}
+
+bool AdaptiveConcurrencyLimiter::startSampleLocked() {
+    if (cooldown_samples_ > 0) {
+        cooldown_samples_--;
+        return true;
+    }
+    return false;
+}
+
+void AdaptiveConcurrencyLimiter::decreaseLocked(bool cooling_down) {
+    // The samples that follow a decrease were mostly sent under the old limit, so they say
+    // nothing about the new one: wait a limit's worth of samples (about one round trip)
+    if (cooling_down) {
+        return;
+    }
+    limit_ = std::max(static_cast<double>(config_.min_limit), limit_ * config_.backoff_ratio);
+    cooldown_samples_ = static_cast<int>(limit_);
+}
+
+std::shared_ptr<AdaptiveConcurrencyLimiter> ConcurrencyLimiterRegistry::ForTarget(const std::string& target) {
+    if (!config_.enabled) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& limiter = limiters_[target];
+    if (!limiter) {
+        limiter = std::make_shared<AdaptiveConcurrencyLimiter>(config_);
+    }
+    return limiter;
+}
+
+}  // namespace resilience
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,75 @@
+#include "croupier/sdk/resilience/retry_budget.h"
+
+#include <algorithm>
+
+namespace croupier {
+namespace sdk {
+namespace resilience {
+
+RetryBudget::RetryBudget(const RetryBudgetConfig& config) : config_(config) {
+    config_.window_seconds = std::max(1, config_.window_seconds);
+    config_.min_retries_per_second = std::max(0, config_.min_retries_per_second);
+    config_.retry_ratio = std::max(0.0, config_.retry_ratio);
+    buckets_.resize(static_cast<size_t>(config_.window_seconds));
+}
+
+void RetryBudget::RecordSuccess(Clock::time_point now) {
+    if (!config_.enabled) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    currentBucket(now).successes++;
+}
+
+bool RetryBudget::TryAcquireRetry(Clock::time_point now) {
+    if (!config_.enabled) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (availableLocked(now) <= 0) {
+        return false;
+    }
+    currentBucket(now).retries++;
+    return true;
+}
+
+int64_t RetryBudget::Available(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return availableLocked(now);
+}
+
+RetryBudget::Bucket& RetryBudget::currentBucket(Clock::time_point now) {
+    const int64_t second = toSecond(now);
+    Bucket& bucket = buckets_[static_cast<size_t>(second % static_cast<int64_t>(buckets_.size()))];
+    if (bucket.second != second) {
+        bucket = Bucket{};
+        bucket.second = second;
+    }
+    return bucket;
+}
+
+int64_t RetryBudget::availableLocked(Clock::time_point now) const {
+    const int64_t second = toSecond(now);
+    const int64_t window = static_cast<int64_t>(buckets_.size());
+
+    int64_t successes = 0;
+    int64_t retries = 0;
+    for (const auto& bucket : buckets_) {
+        if (bucket.second >= 0 && bucket.second > second - window && bucket.second <= second) {
+            successes += bucket.successes;
+            retries += bucket.retries;
+        }
+    }
+
+    const int64_t allowed = static_cast<int64_t>(config_.min_retries_per_second) * window +
+                            static_cast<int64_t>(config_.retry_ratio * static_cast<double>(successes));
+    return allowed - retries;
+}
+
+int64_t RetryBudget::toSecond(Clock::time_point now) const {
+    return std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+}
+
+}  // namespace resilience
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,298 @@
+#include "croupier/sdk/runtime.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+namespace croupier {
+namespace sdk {
+
+namespace {
+
+#ifdef _WIN32
+using PollEntry = WSAPOLLFD;
+int PollFds(PollEntry* entries, size_t count, int timeout_ms) {
+    return WSAPoll(entries, static_cast<ULONG>(count), timeout_ms);
+}
+constexpr short kReadable = POLLRDNORM;
+#else
+using PollEntry = pollfd;
+int PollFds(PollEntry* entries, size_t count, int timeout_ms) {
+    return poll(entries, static_cast<nfds_t>(count), timeout_ms);
+}
+constexpr short kReadable = POLLIN;
+#endif
+
+// Without a pollable wakeup descriptor the reactor re-checks its sources at this interval
+constexpr int kFallbackPollMs = 50;
+
+}  // namespace
+
+Runtime::Runtime(const RuntimeConfig& config) : config_(config) {
+    if (!config_.executor) {
+        const int count = std::max(1, config_.worker_threads);
+        workers_.reserve(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            workers_.emplace_back(&Runtime::workerLoop, this);
+        }
+    }
+    reactor_ = std::thread(&Runtime::reactorLoop, this);
+}
+
+Runtime::~Runtime() {
+    Shutdown();
+}
+
+void Runtime::Post(Task task) {
+    if (!task) {
+        return;
+    }
+    if (config_.executor) {
+        config_.executor->Post(std::move(task));
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopping_) {
+            queue_.push_back(std::move(task));
+            work_cv_.notify_one();
+            return;
+        }
+    }
+    // Once Shutdown starts, workers exit as soon as the queue is empty and a task queued now could be
+    // left behind; run inline so owners waiting on the task still see it finish
+    task();
+}
+
+Runtime::SourceId Runtime::ScheduleAfter(std::chrono::milliseconds delay, Task task) {
+    auto source = std::make_shared<Source>();
+    source->task = std::move(task);
+    source->due = std::chrono::steady_clock::now() + delay;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    source->id = next_source_id_++;
+    sources_.emplace(source->id, source);
+    reactor_wakeup_.Notify();
+    return source->id;
+}
+
+Runtime::SourceId Runtime::SchedulePeriodic(std::chrono::milliseconds interval, Task task) {
+    auto source = std::make_shared<Source>();
+    source->task = std::move(task);
+    source->interval = std::max(interval, std::chrono::milliseconds(1));
+    source->due = std::chrono::steady_clock::now() + source->interval;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    source->id = next_source_id_++;
+    sources_.emplace(source->id, source);
+    reactor_wakeup_.Notify();
+    return source->id;
+}
+
+Runtime::SourceId Runtime::WatchReadable(int fd, Task callback) {
+    auto source = std::make_shared<Source>();
+    source->task = std::move(callback);
+    source->fd = fd;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    source->id = next_source_id_++;
+    sources_.emplace(source->id, source);
+    reactor_wakeup_.Notify();
+    return source->id;
+}
+
+void Runtime::Cancel(SourceId id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = sources_.find(id);
+    if (it == sources_.end()) {
+        return;
+    }
+    std::shared_ptr<Source> source = it->second;
+    sources_.erase(it);
+    source->cancelled = true;
+    reactor_wakeup_.Notify();
+
+    // A callback that was posted but has not started sees the flag and returns without running
+    const std::thread::id self = std::this_thread::get_id();
+    idle_cv_.wait(lock, [&] {
+        return !source->running || source->runner == std::thread::id() || source->runner == self;
+    });
+}
+
+size_t Runtime::ThreadCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return workers_.size() + (reactor_.joinable() ? 1 : 0);
+}
+
+void Runtime::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    reactor_wakeup_.Notify();
+    if (reactor_.joinable()) {
+        reactor_.join();
+    }
+
+    work_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    workers_.clear();
+    sources_.clear();
+}
+
+void Runtime::workerLoop() {
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        try {
+            task();
+        } catch (...) {
+            // Tasks report their own failures; one throwing must not take down the pool
+        }
+    }
+}
+
+void Runtime::reactorLoop() {
+    std::vector<PollEntry> entries;
+    std::vector<std::shared_ptr<Source>> watched;
+    std::vector<std::shared_ptr<Source>> ready;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        entries.clear();
+        watched.clear();
+        if (reactor_wakeup_.Fd() >= 0) {
+            PollEntry wakeup{};
+            wakeup.fd = reactor_wakeup_.Fd();
+            wakeup.events = kReadable;
+            entries.push_back(wakeup);
+        }
+
+        // Sources with a callback in flight are not armed again until it returns
+        int timeout_ms = reactor_wakeup_.Fd() >= 0 ? -1 : kFallbackPollMs;
+        const auto now = std::chrono::steady_clock::now();
+        for (const auto& [id, source] : sources_) {
+            if (source->running) {
+                continue;
+            }
+            if (source->fd >= 0) {
+                PollEntry entry{};
+                entry.fd = source->fd;
+                entry.events = kReadable;
+                entries.push_back(entry);
+                watched.push_back(source);
+                continue;
+            }
+            const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(source->due - now).count();
+            const int wait_ms = static_cast<int>(std::max<int64_t>(0, wait));
+            timeout_ms = timeout_ms < 0 ? wait_ms : std::min(timeout_ms, wait_ms);
+        }
+
+        lock.unlock();
+        const int polled = entries.empty() ? 0 : PollFds(entries.data(), entries.size(), timeout_ms);
+        if (entries.empty() && timeout_ms > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+        }
+        reactor_wakeup_.Clear();
+        lock.lock();
+
+        ready.clear();
+        const size_t first_watch = entries.size() - watched.size();
+        for (size_t i = 0; polled > 0 && i < watched.size(); ++i) {
+            if (entries[first_watch + i].revents != 0 && !watched[i]->cancelled) {
+                ready.push_back(watched[i]);
+            }
+        }
+        const auto fired_at = std::chrono::steady_clock::now();
+        for (const auto& [id, source] : sources_) {
+            if (source->fd < 0 && !source->running && source->due <= fired_at) {
+                ready.push_back(source);
+            }
+        }
+        for (const auto& source : ready) {
+            source->running = true;
+        }
+
+        lock.unlock();
+        for (const auto& source : ready) {
+            fire(source);
+        }
+        lock.lock();
+    }
+}
+
+void Runtime::fire(const std::shared_ptr<Source>& source) {
+    Post([this, source]() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (source->cancelled) {
+                source->running = false;
+                idle_cv_.notify_all();
+                return;
+            }
+            source->runner = std::this_thread::get_id();
+        }
+        try {
+            source->task();
+        } catch (...) {
+            // Same policy as pool tasks
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            source->running = false;
+            source->runner = std::thread::id();
+            if (source->interval.count() > 0) {
+                source->due = std::chrono::steady_clock::now() + source->interval;
+            } else if (source->fd < 0) {
+                sources_.erase(source->id);  // One-shot timers stay cancellable until they finish
+            }
+            idle_cv_.notify_all();
+        }
+        reactor_wakeup_.Notify();
+    });
+}
+
+void TaskGroup::Post(Executor& executor, Executor::Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        outstanding_++;
+    }
+    executor.Post([this, task = std::move(task)]() {
+        try {
+            task();
+        } catch (...) {
+            // Tasks report their own failures
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--outstanding_ == 0) {
+            cv_.notify_all();
+        }
+    });
+}
+
+void TaskGroup::Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return outstanding_ == 0; });
+}
+
+}  // namespace sdk
+}  // namespace croupier
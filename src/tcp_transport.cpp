@@ -4,6 +4,7 @@
  */
 
 #include "croupier/sdk/tcp_transport.h"
+#include <algorithm>
 #include <stdexcept>
 #include <cstring>
 
@@ -15,6 +16,7 @@
 #include <errno.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <unistd.h>
 #endif
@@ -60,7 +62,9 @@ TCPTransport::TCPTransport(TCPTransport&& other) noexcept
       connected_(other.connected_.load()),
       closing_(other.closing_.load()),
       next_req_id_(other.next_req_id_.load()),
+      read_buffer_(std::move(other.read_buffer_)),
       pending_responses_(std::move(other.pending_responses_)),
+      pending_handlers_(std::move(other.pending_handlers_)),
       read_thread_(std::move(other.read_thread_)) {
     other.socket_ = INVALID_SOCKET_VALUE;
     other.connected_ = false;
@@ -77,7 +81,9 @@ TCPTransport& TCPTransport::operator=(TCPTransport&& other) noexcept {
         connected_ = other.connected_.load();
         closing_ = other.closing_.load();
         next_req_id_ = other.next_req_id_.load();
+        read_buffer_ = std::move(other.read_buffer_);
         pending_responses_ = std::move(other.pending_responses_);
+        pending_handlers_ = std::move(other.pending_handlers_);
         read_thread_ = std::move(other.read_thread_);
 
         other.socket_ = INVALID_SOCKET_VALUE;
@@ -86,6 +92,10 @@ TCPTransport& TCPTransport::operator=(TCPTransport&& other) noexcept {
     return *this;
 }
 
+void TCPTransport::SetPolled(bool polled) {
+    polled_ = polled;
+}
+
 void TCPTransport::Connect() {
     if (connected_) {
         return;
@@ -141,9 +151,12 @@ void TCPTransport::Connect() {
 
     connected_ = true;
     closing_ = false;
+    read_buffer_.clear();
 
     // Start read loop
-    read_thread_ = std::thread(&TCPTransport::ReadLoop, this);
+    if (!polled_) {
+        read_thread_ = std::thread(&TCPTransport::ReadLoop, this);
+    }
 }
 
 void TCPTransport::Close() {
@@ -151,16 +164,37 @@ void TCPTransport::Close() {
     connected_ = false;
 
     if (socket_ != INVALID_SOCKET_VALUE) {
-        closesocket(socket_);
-        socket_ = INVALID_SOCKET_VALUE;
+        // Wake the read loop, which may be blocked in recv; the socket is released once it has exited
+#ifdef _WIN32
+        shutdown(socket_, SD_BOTH);
+#else
+        shutdown(socket_, SHUT_RDWR);
+#endif
     }
 
-    if (read_thread_.joinable()) {
+    // ReadLoop closes the transport itself when the peer disconnects; it is joined by a later Close
+    if (read_thread_.joinable() && read_thread_.get_id() != std::this_thread::get_id()) {
         read_thread_.join();
     }
 
-    std::lock_guard<std::mutex> lock(pending_mutex_);
-    pending_responses_.clear();
+    if (socket_ != INVALID_SOCKET_VALUE) {
+        closesocket(socket_);
+        socket_ = INVALID_SOCKET_VALUE;
+    }
+
+    // Fail calls still waiting instead of letting them run into their timeout
+    std::unordered_map<uint32_t, PendingHandler> handlers;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        for (auto& entry : pending_responses_) {
+            entry.second->Abort();
+        }
+        pending_responses_.clear();
+        handlers.swap(pending_handlers_);
+    }
+    for (auto& entry : handlers) {
+        entry.second.on_response(Error(StatusCode::UNAVAILABLE, "Connection closed while waiting for response"));
+    }
 }
 
 bool TCPTransport::IsConnected() const {
@@ -169,22 +203,105 @@ bool TCPTransport::IsConnected() const {
 
 std::pair<uint32_t, std::vector<uint8_t>> TCPTransport::Call(
     uint32_t msg_type, const std::vector<uint8_t>& data) {
+    return TryCall(msg_type, data).value();
+}
+
+Result<std::pair<uint32_t, std::vector<uint8_t>>> TCPTransport::TryCall(
+    uint32_t msg_type, const std::vector<uint8_t>& data) {
 
     if (!connected_) {
-        throw std::runtime_error("Not connected");
+        return Error(StatusCode::UNAVAILABLE, "Not connected");
     }
 
     uint32_t req_id = next_req_id_++;
-    auto latch = std::make_unique<ResponseLatch>();
+    auto latch = std::make_shared<ResponseLatch>();
 
     {
         std::lock_guard<std::mutex> lock(pending_mutex_);
-        pending_responses_[req_id] = std::move(latch);
+        pending_responses_[req_id] = latch;
     }
 
-    // Create frame: [4-byte length][8-byte protocol header][body]
-    size_t frame_size = FRAME_HEADER_BYTES + PROTOCOL_HEADER_SIZE + data.size();
-    std::vector<uint8_t> frame(frame_size);
+    std::vector<uint8_t> frame;
+    AppendFrame(frame, msg_type, req_id, data);
+    if (!SendFrames(frame)) {
+        ForgetPending(req_id);
+        return Error(StatusCode::UNAVAILABLE, "Failed to send complete frame");
+    }
+
+    return AwaitResponse(req_id, *latch);
+}
+
+Result<uint32_t> TCPTransport::CallAsync(uint32_t msg_type, const std::vector<uint8_t>& data,
+                                         ResponseHandler on_response) {
+    if (!connected_) {
+        return Error(StatusCode::UNAVAILABLE, "Not connected");
+    }
+
+    ExpireHandlers();  // A threaded transport has no ProcessIncoming() calls to fail overdue requests
+    const uint32_t req_id = next_req_id_++;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_handlers_[req_id] = {std::move(on_response),
+                                     std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms_)};
+    }
+
+    std::vector<uint8_t> frame;
+    AppendFrame(frame, msg_type, req_id, data);
+    if (!SendFrames(frame)) {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_handlers_.erase(req_id);
+        return Error(StatusCode::UNAVAILABLE, "Failed to send complete frame");
+    }
+    return req_id;
+}
+
+std::vector<Result<std::pair<uint32_t, std::vector<uint8_t>>>> TCPTransport::TryCallBatch(
+    const std::vector<std::pair<uint32_t, std::vector<uint8_t>>>& requests) {
+
+    std::vector<Result<std::pair<uint32_t, std::vector<uint8_t>>>> results;
+    results.reserve(requests.size());
+    if (!connected_) {
+        for (size_t i = 0; i < requests.size(); ++i) {
+            results.emplace_back(Error(StatusCode::UNAVAILABLE, "Not connected"));
+        }
+        return results;
+    }
+
+    std::vector<uint32_t> req_ids;
+    std::vector<std::shared_ptr<ResponseLatch>> latches;
+    std::vector<uint8_t> frames;
+    for (const auto& request : requests) {
+        const uint32_t req_id = next_req_id_++;
+        auto latch = std::make_shared<ResponseLatch>();
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_responses_[req_id] = latch;
+        }
+        req_ids.push_back(req_id);
+        latches.push_back(std::move(latch));
+        AppendFrame(frames, request.first, req_id, request.second);
+    }
+
+    // All frames leave in one write; the responses are then collected in request order
+    if (!SendFrames(frames)) {
+        for (uint32_t req_id : req_ids) {
+            ForgetPending(req_id);
+            results.emplace_back(Error(StatusCode::UNAVAILABLE, "Failed to send complete frame"));
+        }
+        return results;
+    }
+    for (size_t i = 0; i < req_ids.size(); ++i) {
+        results.push_back(AwaitResponse(req_ids[i], *latches[i]));
+    }
+    return results;
+}
+
+void TCPTransport::AppendFrame(std::vector<uint8_t>& out, uint32_t msg_type, uint32_t req_id,
+                               const std::vector<uint8_t>& data) {
+    // Frame: [4-byte length][8-byte protocol header][body]
+    const size_t offset = out.size();
+    out.resize(offset + FRAME_HEADER_BYTES + PROTOCOL_HEADER_SIZE + data.size());
+    uint8_t* frame = out.data() + offset;
 
     // Frame length (big-endian)
     uint32_t payload_size = static_cast<uint32_t>(PROTOCOL_HEADER_SIZE + data.size());
@@ -195,102 +312,242 @@ std::pair<uint32_t, std::vector<uint8_t>> TCPTransport::Call(
 
     // Protocol header
     frame[4] = VERSION_1;
-    PutMsgId(frame.data() + 5, msg_type);
+    PutMsgId(frame + 5, msg_type);
     frame[8] = (req_id >> 24) & 0xFF;
     frame[9] = (req_id >> 16) & 0xFF;
     frame[10] = (req_id >> 8) & 0xFF;
     frame[11] = req_id & 0xFF;
 
     // Request body
-    std::memcpy(frame.data() + 12, data.data(), data.size());
-
-    // Send frame
-    ssize_t sent = send(socket_, reinterpret_cast<const char*>(frame.data()),
-                       frame.size(), 0);
-    if (sent != static_cast<ssize_t>(frame.size())) {
-        throw std::runtime_error("Failed to send complete frame");
+    if (!data.empty()) {
+        std::memcpy(frame + 12, data.data(), data.size());
     }
+}
 
-    // Get response latch
-    std::unique_ptr<ResponseLatch> response_latch;
-    {
-        std::lock_guard<std::mutex> lock(pending_mutex_);
-        auto it = pending_responses_.find(req_id);
-        if (it != pending_responses_.end()) {
-            response_latch = std::move(it->second);
-            pending_responses_.erase(it);
+bool TCPTransport::SendFrames(const std::vector<uint8_t>& frames) {
+    // Callers share the connection, so one caller's frames must not interleave with another's
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    size_t offset = 0;
+    while (offset < frames.size()) {
+        ssize_t sent = send(socket_, reinterpret_cast<const char*>(frames.data() + offset),
+                            frames.size() - offset, 0);
+        if (sent <= 0) {
+            return false;
         }
+        offset += static_cast<size_t>(sent);
     }
+    return true;
+}
 
-    if (!response_latch) {
-        throw std::runtime_error("Response latch not found");
+Result<std::pair<uint32_t, std::vector<uint8_t>>> TCPTransport::AwaitResponse(uint32_t req_id,
+                                                                              ResponseLatch& latch) {
+    // The latch stays registered while waiting so ReadLoop can deliver the response
+    const bool signalled = polled_ ? PumpUntilReady(latch, timeout_ms_) : latch.Wait(timeout_ms_);
+    ForgetPending(req_id);
+    if (!signalled) {
+        return Error(StatusCode::DEADLINE_EXCEEDED, "Timeout waiting for response");
     }
-
-    // Wait for response
-    if (!response_latch->Wait(timeout_ms_)) {
-        throw std::runtime_error("Timeout waiting for response");
+    if (latch.aborted) {
+        return Error(StatusCode::UNAVAILABLE, "Connection closed while waiting for response");
     }
 
-    return {response_latch->msg_id, std::move(response_latch->body)};
+    return std::make_pair(latch.msg_id, std::move(latch.body));
 }
 
-void TCPTransport::ReadLoop() {
-    uint8_t header_buf[FRAME_HEADER_BYTES];
+size_t TCPTransport::PendingCalls() const {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    return pending_responses_.size();
+}
 
-    while (!closing_ && socket_ != INVALID_SOCKET_VALUE) {
-        // Read frame header
-        int n = ReadFully(header_buf, FRAME_HEADER_BYTES);
-        if (n < static_cast<int>(FRAME_HEADER_BYTES)) {
+int TCPTransport::ProcessIncoming() {
+    if (!polled_) {
+        return 0;
+    }
+    std::unique_lock<std::mutex> lock(read_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return 0;
+    }
+    int frames = 0;
+    while (connected_ && WaitReadable(0)) {
+        const int routed = ReadAvailable() ? RouteBufferedFrames() : -1;
+        if (routed < 0) {
+            Close();
             break;
         }
+        frames += routed;
+    }
+    lock.unlock();
+    ExpireHandlers();
+    return frames;
+}
 
-        // Parse frame size
-        uint32_t frame_size = (static_cast<uint32_t>(header_buf[0]) << 24) |
-                             (static_cast<uint32_t>(header_buf[1]) << 16) |
-                             (static_cast<uint32_t>(header_buf[2]) << 8) |
-                             static_cast<uint32_t>(header_buf[3]);
-
-        if (frame_size == 0 || frame_size > MAX_FRAME_BYTES) {
-            break;
+bool TCPTransport::PumpUntilReady(ResponseLatch& latch, int timeout_ms) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    std::lock_guard<std::mutex> lock(read_mutex_);
+    while (!latch.Ready()) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0 || !connected_) {
+            return false;
         }
+        if (WaitReadable(static_cast<int>(remaining.count())) && (!ReadAvailable() || RouteBufferedFrames() < 0)) {
+            Close();
+            return latch.Ready();
+        }
+    }
+    return true;
+}
 
-        // Read frame payload
-        std::vector<uint8_t> payload(frame_size);
-        n = ReadFully(payload.data(), frame_size);
-        if (n < static_cast<int>(frame_size)) {
+bool TCPTransport::WaitReadable(int timeout_ms) const {
+#ifdef _WIN32
+    WSAPOLLFD fd{};
+    fd.fd = socket_;
+    fd.events = POLLRDNORM;
+    return WSAPoll(&fd, 1, timeout_ms) > 0;
+#else
+    pollfd fd{};
+    fd.fd = socket_;
+    fd.events = POLLIN;
+    return poll(&fd, 1, timeout_ms) > 0;
+#endif
+}
+
+void TCPTransport::ForgetPending(uint32_t req_id) {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    pending_responses_.erase(req_id);
+}
+
+void TCPTransport::ReadLoop() {
+    while (!closing_ && socket_ != INVALID_SOCKET_VALUE) {
+        if (!ReadFrame()) {
             break;
         }
+    }
 
-        // Parse protocol header
-        if (payload.size() < PROTOCOL_HEADER_SIZE) {
-            continue;
-        }
+    if (!closing_) {
+        Close();
+    }
+}
+
+bool TCPTransport::ReadFrame() {
+    uint8_t header_buf[FRAME_HEADER_BYTES];
 
-        uint8_t version = payload[0];
-        if (version != VERSION_1) {
-            continue;
+    // Read frame header
+    int n = ReadFully(header_buf, FRAME_HEADER_BYTES);
+    if (n < static_cast<int>(FRAME_HEADER_BYTES)) {
+        return false;
+    }
+
+    // Parse frame size
+    uint32_t frame_size = (static_cast<uint32_t>(header_buf[0]) << 24) |
+                         (static_cast<uint32_t>(header_buf[1]) << 16) |
+                         (static_cast<uint32_t>(header_buf[2]) << 8) |
+                         static_cast<uint32_t>(header_buf[3]);
+
+    if (frame_size == 0 || frame_size > MAX_FRAME_BYTES) {
+        return false;
+    }
+
+    // Read frame payload
+    std::vector<uint8_t> payload(frame_size);
+    n = ReadFully(payload.data(), frame_size);
+    if (n < static_cast<int>(frame_size)) {
+        return false;
+    }
+
+    RouteFrame(payload.data(), payload.size());
+    return true;
+}
+
+bool TCPTransport::ReadAvailable() {
+    // Called once the socket polled readable, so this recv returns without waiting
+    static constexpr size_t kReadChunkBytes = 64 * 1024;
+    const size_t offset = read_buffer_.size();
+    read_buffer_.resize(offset + kReadChunkBytes);
+    ssize_t n = recv(socket_, reinterpret_cast<char*>(read_buffer_.data() + offset), kReadChunkBytes, 0);
+    read_buffer_.resize(offset + static_cast<size_t>(std::max<ssize_t>(n, 0)));
+    if (n > 0) {
+        return true;
+    }
+#ifndef _WIN32
+    if (n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return true;
+    }
+#endif
+    return false;  // Peer closed the connection or the socket failed
+}
+
+int TCPTransport::RouteBufferedFrames() {
+    int frames = 0;
+    size_t offset = 0;
+    while (read_buffer_.size() - offset >= FRAME_HEADER_BYTES) {
+        const uint8_t* header = read_buffer_.data() + offset;
+        const uint32_t frame_size = (static_cast<uint32_t>(header[0]) << 24) |
+                                    (static_cast<uint32_t>(header[1]) << 16) |
+                                    (static_cast<uint32_t>(header[2]) << 8) |
+                                    static_cast<uint32_t>(header[3]);
+        if (frame_size == 0 || frame_size > MAX_FRAME_BYTES) {
+            return -1;
+        }
+        if (read_buffer_.size() - offset - FRAME_HEADER_BYTES < frame_size) {
+            break;  // The rest of this frame has not arrived yet
         }
+        RouteFrame(header + FRAME_HEADER_BYTES, frame_size);
+        offset += FRAME_HEADER_BYTES + frame_size;
+        frames++;
+    }
+    read_buffer_.erase(read_buffer_.begin(), read_buffer_.begin() + static_cast<std::ptrdiff_t>(offset));
+    return frames;
+}
 
-        uint32_t msg_id = GetMsgId(payload.data() + 1);
-        uint32_t req_id = (static_cast<uint32_t>(payload[4]) << 24) |
-                         (static_cast<uint32_t>(payload[5]) << 16) |
-                         (static_cast<uint32_t>(payload[6]) << 8) |
-                         static_cast<uint32_t>(payload[7]);
+void TCPTransport::RouteFrame(const uint8_t* payload, size_t size) {
+    // Parse protocol header
+    if (size < PROTOCOL_HEADER_SIZE || payload[0] != VERSION_1) {
+        return;
+    }
 
-        size_t body_size = payload.size() - PROTOCOL_HEADER_SIZE;
-        std::vector<uint8_t> body(body_size);
-        std::memcpy(body.data(), payload.data() + PROTOCOL_HEADER_SIZE, body_size);
+    uint32_t msg_id = GetMsgId(payload + 1);
+    uint32_t req_id = (static_cast<uint32_t>(payload[4]) << 24) |
+                     (static_cast<uint32_t>(payload[5]) << 16) |
+                     (static_cast<uint32_t>(payload[6]) << 8) |
+                     static_cast<uint32_t>(payload[7]);
+    std::vector<uint8_t> body(payload + PROTOCOL_HEADER_SIZE, payload + size);
 
-        // Route to pending request
+    // Route to pending request
+    ResponseHandler on_response;
+    {
         std::lock_guard<std::mutex> lock(pending_mutex_);
         auto it = pending_responses_.find(req_id);
         if (it != pending_responses_.end()) {
             it->second->Signal(std::move(body), msg_id);
+            return;
+        }
+        auto handler = pending_handlers_.find(req_id);
+        if (handler == pending_handlers_.end()) {
+            return;
         }
+        on_response = std::move(handler->second.on_response);
+        pending_handlers_.erase(handler);
     }
+    on_response(std::make_pair(msg_id, std::move(body)));
+}
 
-    if (!closing_) {
-        Close();
+void TCPTransport::ExpireHandlers() {
+    std::vector<ResponseHandler> expired;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        const auto now = std::chrono::steady_clock::now();
+        for (auto it = pending_handlers_.begin(); it != pending_handlers_.end();) {
+            if (now < it->second.deadline) {
+                ++it;
+                continue;
+            }
+            expired.push_back(std::move(it->second.on_response));
+            it = pending_handlers_.erase(it);
+        }
+    }
+    for (auto& on_response : expired) {
+        on_response(Error(StatusCode::DEADLINE_EXCEEDED, "Timeout waiting for response"));
     }
 }
 
@@ -0,0 +1,95 @@
+#include "croupier/sdk/threading/wakeup_fd.h"
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace croupier {
+namespace sdk {
+namespace threading {
+
+WakeupFd::WakeupFd() {
+#if defined(__linux__)
+    read_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    write_fd_ = read_fd_;
+#elif !defined(_WIN32)
+    int fds[2];
+    if (pipe(fds) == 0) {
+        for (int fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        read_fd_ = fds[0];
+        write_fd_ = fds[1];
+    }
+#endif
+}
+
+WakeupFd::~WakeupFd() {
+#if !defined(_WIN32)
+    if (write_fd_ >= 0 && write_fd_ != read_fd_) {
+        close(write_fd_);
+    }
+    if (read_fd_ >= 0) {
+        close(read_fd_);
+    }
+#endif
+}
+
+void WakeupFd::Notify() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_) {
+            return;
+        }
+        pending_ = true;
+#if !defined(_WIN32)
+        if (write_fd_ >= 0) {
+            const uint64_t one = 1;
+            // Nonblocking: a full pipe is already readable, so a failed write loses nothing
+            [[maybe_unused]] ssize_t written = write(write_fd_, &one, sizeof(one));
+        }
+#endif
+    }
+    cv_.notify_all();
+}
+
+void WakeupFd::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!pending_) {
+        return;
+    }
+    pending_ = false;
+#if !defined(_WIN32)
+    if (read_fd_ >= 0) {
+        uint64_t buffer[8];
+        while (read(read_fd_, buffer, sizeof(buffer)) > 0) {
+        }
+    }
+#endif
+}
+
+bool WakeupFd::Wait(int timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (timeout_ms < 0) {
+        cv_.wait(lock, [this] { return pending_; });
+        return true;
+    }
+    return cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this] { return pending_; });
+}
+
+bool WakeupFd::Pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_;
+}
+
+}  // namespace threading
+}  // namespace sdk
+}  // namespace croupier
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/agent_connection.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace croupier::sdk;
+
+namespace {
+
+// Minimal agent: accepts one connection and echoes every request frame, counting them
+class EchoAgent {
+public:
+    EchoAgent() {
+        listen_socket_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(listen_socket_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listen_socket_, 1);
+        socklen_t length = sizeof(addr);
+        getsockname(listen_socket_, reinterpret_cast<sockaddr*>(&addr), &length);
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this]() { Serve(); });
+    }
+
+    ~EchoAgent() {
+        Disconnect();
+        thread_.join();
+        closesocket(listen_socket_);
+        if (client_socket_ != INVALID_SOCKET_VALUE) {
+            closesocket(client_socket_);
+        }
+    }
+
+    std::string Address() const { return "127.0.0.1:" + std::to_string(port_); }
+
+    int Frames() const { return frames_; }
+
+    void Disconnect() {
+        shutdown(listen_socket_, SHUT_RDWR);
+        if (client_socket_ != INVALID_SOCKET_VALUE) {
+            shutdown(client_socket_, SHUT_RDWR);
+        }
+    }
+
+private:
+    void Serve() {
+        client_socket_ = accept(listen_socket_, nullptr, nullptr);
+        if (client_socket_ == INVALID_SOCKET_VALUE) {
+            return;
+        }
+        for (;;) {
+            uint8_t header[4];
+            if (!ReadAll(header, sizeof(header))) {
+                return;
+            }
+            const uint32_t size = (uint32_t(header[0]) << 24) | (uint32_t(header[1]) << 16) |
+                                  (uint32_t(header[2]) << 8) | uint32_t(header[3]);
+            std::vector<uint8_t> frame(sizeof(header) + size);
+            std::memcpy(frame.data(), header, sizeof(header));
+            if (!ReadAll(frame.data() + sizeof(header), size)) {
+                return;
+            }
+            frames_++;
+            send(client_socket_, reinterpret_cast<const char*>(frame.data()), frame.size(), MSG_NOSIGNAL);
+        }
+    }
+
+    bool ReadAll(uint8_t* buffer, size_t count) {
+        size_t offset = 0;
+        while (offset < count) {
+            const ssize_t n = recv(client_socket_, reinterpret_cast<char*>(buffer) + offset, count - offset, 0);
+            if (n <= 0) {
+                return false;
+            }
+            offset += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    int port_ = 0;
+    std::atomic<int> frames_{0};
+    socket_t listen_socket_ = INVALID_SOCKET_VALUE;
+    socket_t client_socket_ = INVALID_SOCKET_VALUE;
+    std::thread thread_;
+};
+
+AgentConnectionConfig MakeConfig(const EchoAgent& agent) {
+    AgentConnectionConfig config;
+    config.agent_addr = "tcp://" + agent.Address();
+    config.timeout_seconds = 2;
+    config.heartbeat_interval = 3600;  // Tests send heartbeat rounds by hand
+    config.runtime = std::make_shared<Runtime>();
+    return config;
+}
+
+}  // namespace
+
+TEST(AgentConnectionTest, RequiresRuntime) {
+    EXPECT_THROW(AgentConnection connection{AgentConnectionConfig()}, std::runtime_error);
+}
+
+TEST(AgentConnectionTest, TenantsShareOneTransport) {
+    EchoAgent agent;
+    AgentConnection connection(MakeConfig(agent));
+
+    auto first = connection.Acquire();
+    auto second = connection.Acquire();
+    EXPECT_EQ(first, second);
+
+    // Responses are read by the runtime reactor, not a transport thread
+    auto response = first->TryCall(protocol::MSG_HEARTBEAT_LOCAL_REQUEST, {7});
+    ASSERT_TRUE(response.ok()) << response.error().ToString();
+    EXPECT_EQ(response.value().second, std::vector<uint8_t>{7});
+    connection.Close();
+}
+
+TEST(AgentConnectionTest, HeartbeatRoundCoversEveryTenantSession) {
+    EchoAgent agent;
+    AgentConnection connection(MakeConfig(agent));
+    connection.Acquire();
+
+    const auto a = connection.AddTenant("shard-a", nullptr);
+    const auto b = connection.AddTenant("shard-b", nullptr);
+    connection.AddTenant("shard-c", nullptr);  // Not registered yet: no heartbeat
+    EXPECT_EQ(connection.TenantCount(), 3U);
+
+    connection.SetSession(a, "session-a");
+    connection.SetSession(b, "session-b");
+    EXPECT_EQ(connection.SendHeartbeats(), 2U);
+    EXPECT_EQ(agent.Frames(), 2);
+
+    connection.SetSession(b, "");
+    connection.RemoveTenant(a);
+    EXPECT_EQ(connection.SendHeartbeats(), 0U);
+    EXPECT_EQ(agent.Frames(), 2);
+    connection.Close();
+}
+
+TEST(AgentConnectionTest, FailedRoundReportsLostSessions) {
+    EchoAgent agent;
+    AgentConnection connection(MakeConfig(agent));
+    auto transport = connection.Acquire();
+
+    std::atomic<int> lost{0};
+    const auto tenant = connection.AddTenant("shard-a", [&](const std::string& error) {
+        EXPECT_FALSE(error.empty());
+        lost++;
+    });
+    connection.SetSession(tenant, "session-a");
+
+    agent.Disconnect();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (transport->IsConnected() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    EXPECT_EQ(connection.SendHeartbeats(), 0U);
+    EXPECT_EQ(lost, 1);
+    EXPECT_EQ(connection.SendHeartbeats(), 0U);  // The lost session is not retried
+    EXPECT_EQ(lost, 1);
+    connection.Close();
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/resilience/circuit_breaker.h"
+#include "test_clock.h"
+
+#include <chrono>
+
+using namespace croupier::sdk;
+using namespace croupier::sdk::resilience;
+using croupier::sdk::test::At;
+
+namespace {
+
+void Fail(CircuitBreaker& breaker, int ms) {
+    ASSERT_TRUE(breaker.AllowRequest(At(ms)));
+    breaker.RecordFailure(At(ms));
+}
+
+void Succeed(CircuitBreaker& breaker, int ms, std::chrono::milliseconds latency = std::chrono::milliseconds(1)) {
+    ASSERT_TRUE(breaker.AllowRequest(At(ms)));
+    breaker.RecordSuccess(latency, At(ms));
+}
+
+}  // namespace
+
+TEST(CircuitBreakerTest, StaysClosedBelowMinimumRequests) {
+    CircuitBreakerConfig config;
+    config.enabled = true;
+    config.minimum_requests = 4;
+    config.open_duration_ms = 1000;
+    CircuitBreaker breaker(config);
+
+    Fail(breaker, 0);
+    Fail(breaker, 1);
+    Fail(breaker, 2);
+    EXPECT_EQ(breaker.GetState(At(3)), CircuitBreaker::State::CLOSED);
+}
+
+TEST(CircuitBreakerTest, OpensOnFailureRateAndRejectsFast) {
+    CircuitBreakerConfig config;
+    config.enabled = true;
+    config.minimum_requests = 4;
+    config.open_duration_ms = 1000;
+    CircuitBreaker breaker(config);
+
+    Succeed(breaker, 0);
+    Succeed(breaker, 1);
+    Fail(breaker, 2);
+    Fail(breaker, 3);
+
+    EXPECT_EQ(breaker.GetState(At(4)), CircuitBreaker::State::OPEN);
+    EXPECT_FALSE(breaker.AllowRequest(At(500)));
+}
+
+TEST(CircuitBreakerTest, HalfOpenProbeClosesCircuitOnSuccess) {
+    CircuitBreakerConfig config;
+    config.enabled = true;
+    config.minimum_requests = 4;
+    config.open_duration_ms = 1000;
+    CircuitBreaker breaker(config);
+    for (int i = 0; i < 4; ++i) {
+        Fail(breaker, i);
+    }
+    ASSERT_EQ(breaker.GetState(At(10)), CircuitBreaker::State::OPEN);
+
+    EXPECT_EQ(breaker.GetState(At(1100)), CircuitBreaker::State::HALF_OPEN);
+    EXPECT_TRUE(breaker.AllowRequest(At(1100)));
+    EXPECT_FALSE(breaker.AllowRequest(At(1101)));  // only one probe at a time
+
+    breaker.RecordSuccess(std::chrono::milliseconds(1), At(1102));
+    EXPECT_EQ(breaker.GetState(At(1103)), CircuitBreaker::State::CLOSED);
+    EXPECT_TRUE(breaker.AllowRequest(At(1104)));
+}
+
+TEST(CircuitBreakerTest, HalfOpenProbeFailureReopensCircuit) {
+    CircuitBreakerConfig config;
+    config.enabled = true;
+    config.minimum_requests = 4;
+    config.open_duration_ms = 1000;
+    CircuitBreaker breaker(config);
+    for (int i = 0; i < 4; ++i) {
+        Fail(breaker, i);
+    }
+
+    ASSERT_TRUE(breaker.AllowRequest(At(1100)));
+    breaker.RecordFailure(At(1200));
+    EXPECT_EQ(breaker.GetState(At(1300)), CircuitBreaker::State::OPEN);
+    EXPECT_FALSE(breaker.AllowRequest(At(2100)));
+    EXPECT_TRUE(breaker.AllowRequest(At(2200)));
+}
+
+TEST(CircuitBreakerTest, SlowCallsOpenCircuit) {
+    CircuitBreakerConfig config;
+    config.enabled = true;
+    config.minimum_requests = 4;
+    config.open_duration_ms = 1000;
+    config.slow_call_threshold_ms = 100;
+    config.slow_call_rate_threshold = 0.75;
+    CircuitBreaker breaker(config);
+
+    Succeed(breaker, 0, std::chrono::milliseconds(10));
+    Succeed(breaker, 1, std::chrono::milliseconds(150));
+    Succeed(breaker, 2, std::chrono::milliseconds(150));
+    EXPECT_EQ(breaker.GetState(At(3)), CircuitBreaker::State::CLOSED);
+    Succeed(breaker, 3, std::chrono::milliseconds(150));
+    EXPECT_EQ(breaker.GetState(At(4)), CircuitBreaker::State::OPEN);
+}
+
+TEST(CircuitBreakerTest, FailuresOutsideWindowAreForgotten) {
+    CircuitBreakerConfig config;
+    config.enabled = true;
+    config.minimum_requests = 4;
+    config.open_duration_ms = 1000;
+    CircuitBreaker breaker(config);
+
+    Fail(breaker, 0);
+    Fail(breaker, 1);
+    Fail(breaker, 2);
+    Fail(breaker, 11000);
+    EXPECT_EQ(breaker.GetState(At(11001)), CircuitBreaker::State::CLOSED);
+}
+
+TEST(CircuitBreakerTest, RegistryKeysByFunctionAndTarget) {
+    CircuitBreakerConfig config;
+    config.enabled = true;
+    CircuitBreakerRegistry registry(config);
+
+    auto wallet_a = registry.For("wallet.get", "svc-a");
+    EXPECT_EQ(wallet_a, registry.For("wallet.get", "svc-a"));
+    EXPECT_NE(wallet_a, registry.For("wallet.get", "svc-b"));
+    EXPECT_NE(wallet_a, registry.For("wallet.credit", "svc-a"));
+
+    // Breakers are opt-in: a default config creates none
+    CircuitBreakerRegistry disabled_registry{CircuitBreakerConfig()};
+    EXPECT_EQ(disabled_registry.For("wallet.get", "svc-a"), nullptr);
+    EXPECT_EQ(CircuitStateToString(CircuitBreaker::State::HALF_OPEN), "HALF_OPEN");
+}
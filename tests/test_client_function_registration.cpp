@@ -237,3 +237,37 @@ TEST_F(ClientFunctionRegistrationTest, FunctionMetadataCompleteness) {
     bool success = client->RegisterFunction(desc, handler);
     EXPECT_TRUE(success);
 }
+
+TEST_F(ClientFunctionRegistrationTest, RegisterZeroCopyFunction) {
+    // 零拷贝处理器与普通处理器注册在同一目录中
+    FunctionViewHandler echo = [](const CallMetadata&, std::string_view payload, ResponseWriter& out) {
+        out.Append(payload);
+    };
+    ASSERT_TRUE(client->RegisterFunction(CreateBasicFunctionDescriptor("player.echo"), echo));
+    ASSERT_TRUE(client->RegisterFunction(CreateBasicFunctionDescriptor("wallet.get"), CreateSimpleHandler("{}")));
+    EXPECT_FALSE(client->RegisterFunction(CreateBasicFunctionDescriptor(""), echo));
+
+    ASSERT_TRUE(client->Connect());
+    EXPECT_NE(client->GetCatalogHash(), 0U);
+    client->Close();
+}
+
+TEST_F(ClientFunctionRegistrationTest, AddAndRemoveFunctionsAfterConnect) {
+    // 连接后增删函数：目录哈希随之变化
+    ASSERT_TRUE(client->RegisterFunction(CreateBasicFunctionDescriptor("player.ban"), CreateSimpleHandler("{}")));
+    ASSERT_TRUE(client->RegisterFunction(CreateBasicFunctionDescriptor("wallet.get"), CreateSimpleHandler("{}")));
+    ASSERT_TRUE(client->Connect());
+    const uint64_t connected_hash = client->GetCatalogHash();
+
+    ASSERT_TRUE(client->RegisterFunction(CreateBasicFunctionDescriptor("item.grant"), CreateSimpleHandler("{}")));
+    EXPECT_NE(client->GetCatalogHash(), connected_hash);
+
+    ASSERT_TRUE(client->UnregisterFunction("player.ban"));
+    EXPECT_FALSE(client->UnregisterFunction("player.ban"));
+
+    // 重新注册相同描述符：目录哈希回到原值
+    ASSERT_TRUE(client->RegisterFunction(CreateBasicFunctionDescriptor("player.ban"), CreateSimpleHandler("{}")));
+    ASSERT_TRUE(client->UnregisterFunction("item.grant"));
+    EXPECT_EQ(client->GetCatalogHash(), connected_hash);
+    client->Close();
+}
@@ -208,3 +208,21 @@ TEST_F(ClientLifecycleTest, CompleteLifecycle) {
     // 完整生命周期成功完成
     SUCCEED();
 }
+
+TEST_F(ClientLifecycleTest, ExternalEventLoopMode) {
+    // 外部事件循环模式：暴露可轮询的 fd，由宿主线程驱动
+    EXPECT_EQ(client->GetEventFd(), -1);
+    EXPECT_EQ(client->ProcessEvents(), 0);
+
+    config.external_event_loop = true;
+    CroupierClient loop_client(config);
+#ifdef __linux__
+    EXPECT_GE(loop_client.GetEventFd(), 0);
+#endif
+    EXPECT_EQ(loop_client.NextTimeoutMs(), -1);
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(loop_client.PollOnce(20), 0);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(15));
+    loop_client.Close();
+}
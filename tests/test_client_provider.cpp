@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/croupier_client.h"
+#include "croupier/sdk/protocol_messages.h"
+#include "croupier/sdk/threading/dispatcher.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace croupier {
+namespace sdk {
+namespace test {
+
+// Drives the provider's local RPC handlers through HandleLocalRequest, the entry point its local
+// endpoint routes every frame the agent forwards through
+class ClientProviderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ClientConfig config;
+        config.game_id = "test-game";
+        config.env = "development";
+        config.disable_logging = true;
+        client_ = std::make_unique<CroupierClient>(config);
+    }
+
+    void TearDown() override { client_->Close(); }
+
+    Result<std::string> Invoke(const std::string& function_id, const std::string& payload,
+                               const std::string& idempotency_key = std::string()) {
+        croupier::sdk::v1::InvokeRequest request;
+        request.set_function_id(function_id);
+        request.set_payload(payload);
+        request.set_idempotency_key(idempotency_key);
+        try {
+            const auto reply = client_->HandleLocalRequest(protocol::MSG_INVOKE_REQUEST, protocol::EncodeBody(request));
+            croupier::sdk::v1::InvokeResponse response;
+            protocol::DecodeBody(protocol::MSG_INVOKE_RESPONSE, reply, &response);
+            return response.payload();
+        } catch (const std::exception& e) {
+            return Error(StatusCode::INTERNAL, e.what());
+        }
+    }
+
+    FunctionDescriptor Describe(const std::string& id) {
+        FunctionDescriptor desc;
+        desc.id = id;
+        desc.version = "1.0.0";
+        return desc;
+    }
+
+    std::unique_ptr<CroupierClient> client_;
+};
+
+TEST_F(ClientProviderTest, RetriedInvocationReplaysTheFirstResponse) {
+    std::atomic<int> runs{0};
+    ASSERT_TRUE(client_->RegisterFunction(Describe("wallet.credit"), [&runs](const std::string&, const std::string&) {
+        return "credited:" + std::to_string(++runs);
+    }));
+    ASSERT_TRUE(client_->Connect());
+
+    auto first = Invoke("wallet.credit", R"({"amount":5})", "req-1");
+    auto retry = Invoke("wallet.credit", R"({"amount":5})", "req-1");
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(retry);
+    EXPECT_EQ(first.value(), "credited:1");
+    EXPECT_EQ(retry.value(), "credited:1");
+    EXPECT_EQ(runs.load(), 1);
+
+    auto other = Invoke("wallet.credit", R"({"amount":5})", "req-2");
+    ASSERT_TRUE(other);
+    EXPECT_EQ(other.value(), "credited:2");
+
+    // Calls without a key are never deduplicated
+    ASSERT_TRUE(Invoke("wallet.credit", R"({"amount":5})"));
+    ASSERT_TRUE(Invoke("wallet.credit", R"({"amount":5})"));
+    EXPECT_EQ(runs.load(), 4);
+}
+
+TEST_F(ClientProviderTest, ConcurrentRetriesRunTheHandlerOnce) {
+    std::atomic<int> runs{0};
+    std::atomic<bool> release{false};
+    ASSERT_TRUE(client_->RegisterFunction(Describe("item.grant"), [&](const std::string&, const std::string&) {
+        runs++;
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return std::string("granted");
+    }));
+    ASSERT_TRUE(client_->Connect());
+
+    Result<std::string> first = Error(StatusCode::UNKNOWN, "not run");
+    std::thread caller([&]() { first = Invoke("item.grant", "{}", "req-1"); });
+    while (runs == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    Result<std::string> retry = Error(StatusCode::UNKNOWN, "not run");
+    std::thread retrier([&]() { retry = Invoke("item.grant", "{}", "req-1"); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release = true;
+    caller.join();
+    retrier.join();
+
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(retry);
+    EXPECT_EQ(retry.value(), "granted");
+    EXPECT_EQ(runs.load(), 1);
+}
+
+TEST_F(ClientProviderTest, UnsupportedMessageIsRejected) {
+    ASSERT_TRUE(client_->RegisterFunction(Describe("wallet.get"),
+                                          [](const std::string&, const std::string&) { return std::string("{}"); }));
+    ASSERT_TRUE(client_->Connect());
+
+    EXPECT_THROW(client_->HandleLocalRequest(protocol::MSG_HEARTBEAT_REQUEST, {}), std::runtime_error);
+    EXPECT_FALSE(Invoke("wallet.missing", "{}", "req-1"));
+}
+
+TEST_F(ClientProviderTest, PureFunctionIsServedFromResponseCache) {
+    std::atomic<int> runs{0};
+    FunctionDescriptor desc = Describe("config.items");
+    desc.cache_ttl_ms = 60000;
+    ASSERT_TRUE(client_->RegisterFunction(desc, [&runs](const std::string&, const std::string& payload) {
+        runs++;
+        return "items:" + payload;
+    }));
+    ASSERT_TRUE(client_->Connect());
+
+    auto first = Invoke("config.items", "shop", "req-1");
+    auto second = Invoke("config.items", "shop", "req-2");
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second.value(), "items:shop");
+    EXPECT_EQ(runs.load(), 1);
+    EXPECT_EQ(client_->GetResponseCacheStats().hits, 1U);
+
+    ASSERT_TRUE(Invoke("config.items", "bank", "req-3"));
+    EXPECT_EQ(runs.load(), 2);
+}
+
+TEST_F(ClientProviderTest, DispatcherDeadlineRejectsCallsNotStartedInTime) {
+    // The test thread plays the world thread and owns the dispatcher
+    threading::Dispatcher world;
+    world.Initialize();
+    std::atomic<int> runs{0};
+    FunctionDescriptor desc = Describe("world.spawn");
+    desc.dispatcher = &world;
+    desc.dispatch_deadline_ms = 50;
+    ASSERT_TRUE(client_->RegisterFunction(desc, [&runs](const std::string&, const std::string&) {
+        runs++;
+        return std::string("spawned");
+    }));
+    ASSERT_TRUE(client_->Connect());
+
+    // Calls arrive on other threads, as they do from the local endpoint. No frame runs while this one
+    // waits, so it is rejected and the late work is skipped.
+    std::thread stale_caller([&]() {
+        auto stale = Invoke("world.spawn", "{}", "req-1");
+        EXPECT_FALSE(stale && stale.value() == "spawned");
+    });
+    stale_caller.join();
+    world.ProcessQueue();
+    EXPECT_EQ(runs.load(), 0);
+
+    std::atomic<bool> pumping{true};
+    std::thread caller([&]() {
+        auto fresh = Invoke("world.spawn", "{}", "req-2");
+        EXPECT_TRUE(fresh && fresh.value() == "spawned");
+        pumping = false;
+    });
+    while (pumping) {
+        world.ProcessQueue();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    caller.join();
+    EXPECT_EQ(runs.load(), 1);
+}
+
+}  // namespace test
+}  // namespace sdk
+}  // namespace croupier
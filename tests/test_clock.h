@@ -0,0 +1,17 @@
+#pragma once
+
+#include <chrono>
+
+namespace croupier {
+namespace sdk {
+namespace test {
+
+// Fixed steady_clock time point for components that take the current time as an argument,
+// so window, TTL and backoff tests do not depend on how fast they run
+inline std::chrono::steady_clock::time_point At(int milliseconds) {
+    return std::chrono::steady_clock::time_point(std::chrono::seconds(1000) + std::chrono::milliseconds(milliseconds));
+}
+
+}  // namespace test
+}  // namespace sdk
+}  // namespace croupier
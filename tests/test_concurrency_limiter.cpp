@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/resilience/concurrency_limiter.h"
+
+#include <chrono>
+
+using namespace croupier::sdk;
+using namespace croupier::sdk::resilience;
+
+TEST(ConcurrencyLimiterTest, ShedsCallsAboveLimit) {
+    ConcurrencyLimitConfig config;
+    config.enabled = true;
+    config.initial_limit = 2;
+    config.max_limit = 10;
+    AdaptiveConcurrencyLimiter limiter(config);
+
+    EXPECT_TRUE(limiter.TryAcquire());
+    EXPECT_TRUE(limiter.TryAcquire());
+    EXPECT_FALSE(limiter.TryAcquire());
+    EXPECT_EQ(limiter.GetInFlight(), 2);
+
+    limiter.OnIgnored();
+    EXPECT_TRUE(limiter.TryAcquire());
+}
+
+TEST(ConcurrencyLimiterTest, DropsDecreaseLimitMultiplicatively) {
+    ConcurrencyLimitConfig config;
+    config.enabled = true;
+    config.initial_limit = 8;
+    config.max_limit = 10;
+    config.backoff_ratio = 0.5;
+    AdaptiveConcurrencyLimiter limiter(config);
+
+    ASSERT_TRUE(limiter.TryAcquire());
+    limiter.OnDropped();
+    EXPECT_EQ(limiter.GetLimit(), 4);
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(limiter.TryAcquire());
+        limiter.OnDropped();
+    }
+    EXPECT_EQ(limiter.GetLimit(), 1);
+    EXPECT_EQ(limiter.GetInFlight(), 0);
+}
+
+TEST(ConcurrencyLimiterTest, LatencyInflationDecreasesLimit) {
+    ConcurrencyLimitConfig config;
+    config.enabled = true;
+    config.initial_limit = 8;
+    config.max_limit = 10;
+    config.backoff_ratio = 0.5;
+    AdaptiveConcurrencyLimiter limiter(config);
+
+    ASSERT_TRUE(limiter.TryAcquire());
+    limiter.OnSuccess(std::chrono::milliseconds(10));  // establishes baseline
+    EXPECT_EQ(limiter.GetLimit(), 8);
+
+    ASSERT_TRUE(limiter.TryAcquire());
+    limiter.OnSuccess(std::chrono::milliseconds(50));
+    EXPECT_EQ(limiter.GetLimit(), 4);
+}
+
+TEST(ConcurrencyLimiterTest, DecreasesOncePerWindowOfInflatedSamples) {
+    ConcurrencyLimitConfig config;
+    config.enabled = true;
+    config.initial_limit = 8;
+    config.max_limit = 10;
+    config.backoff_ratio = 0.5;
+    AdaptiveConcurrencyLimiter limiter(config);
+
+    ASSERT_TRUE(limiter.TryAcquire());
+    limiter.OnSuccess(std::chrono::milliseconds(10));
+
+    // One congested round trip: the samples after the first decrease were sent under the old limit
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(limiter.TryAcquire());
+        limiter.OnSuccess(std::chrono::milliseconds(50));
+    }
+    EXPECT_EQ(limiter.GetLimit(), 4);
+}
+
+TEST(ConcurrencyLimiterTest, RecoversAfterPermanentLatencyIncrease) {
+    ConcurrencyLimitConfig config;
+    config.enabled = true;
+    config.initial_limit = 8;
+    config.max_limit = 10;
+    config.backoff_ratio = 0.5;
+    AdaptiveConcurrencyLimiter limiter(config);
+
+    ASSERT_TRUE(limiter.TryAcquire());
+    limiter.OnSuccess(std::chrono::milliseconds(10));
+
+    // The target gets slower for good; saturated traffic keeps coming at the new latency
+    for (int round = 0; round < 200; ++round) {
+        int acquired = 0;
+        while (limiter.TryAcquire()) {
+            ++acquired;
+        }
+        for (int i = 0; i < acquired; ++i) {
+            limiter.OnSuccess(std::chrono::milliseconds(60));
+        }
+    }
+    EXPECT_EQ(limiter.GetLimit(), 10);
+}
+
+TEST(ConcurrencyLimiterTest, HealthySaturatedTrafficGrowsLimit) {
+    ConcurrencyLimitConfig config;
+    config.enabled = true;
+    config.initial_limit = 2;
+    config.max_limit = 4;
+    AdaptiveConcurrencyLimiter limiter(config);
+
+    for (int round = 0; round < 50; ++round) {
+        int acquired = 0;
+        while (limiter.TryAcquire()) {
+            ++acquired;
+        }
+        for (int i = 0; i < acquired; ++i) {
+            limiter.OnSuccess(std::chrono::milliseconds(10));
+        }
+    }
+    EXPECT_EQ(limiter.GetLimit(), 4);
+}
+
+TEST(ConcurrencyLimiterTest, RegistryKeepsOneLimiterPerTarget) {
+    ConcurrencyLimitConfig config;
+    config.enabled = true;
+    config.initial_limit = 2;
+    config.max_limit = 10;
+    ConcurrencyLimiterRegistry registry(config);
+
+    auto a = registry.ForTarget("svc-a");
+    auto b = registry.ForTarget("svc-b");
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a, registry.ForTarget("svc-a"));
+    EXPECT_NE(a, b);
+
+    ConcurrencyLimiterRegistry disabled_registry{ConcurrencyLimitConfig()};
+    EXPECT_EQ(disabled_registry.ForTarget("svc-a"), nullptr);
+}
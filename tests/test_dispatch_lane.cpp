@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/dispatch/dispatch_lane.h"
+#include "croupier/sdk/dispatch/function_table.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace croupier::sdk;
+using namespace croupier::sdk::dispatch;
+using namespace croupier::sdk::threading;
+
+namespace {
+
+DispatchLane::Clock::time_point In(std::chrono::milliseconds delay) {
+    return DispatchLane::Clock::now() + delay;
+}
+
+// Wait until every caller has queued its call, so a frame sees all of them
+void WaitForPending(const DispatchLane& lane, size_t count) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (lane.PendingCount() < count && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+}  // namespace
+
+// The test thread plays the world thread: it owns the dispatcher and runs its frames
+class DispatchLaneTest : public ::testing::Test {
+protected:
+    void SetUp() override { dispatcher_.Initialize(); }
+
+    Dispatcher dispatcher_;
+};
+
+TEST_F(DispatchLaneTest, RunsWorkOnTheDispatcherThread) {
+    DispatchLane lane(dispatcher_, 0);
+    const auto world_thread = std::this_thread::get_id();
+
+    auto call = std::async(std::launch::async, [&]() {
+        return lane.Run([&]() { return std::this_thread::get_id() == world_thread ? "world" : "other"; },
+                        In(std::chrono::seconds(5)));
+    });
+    WaitForPending(lane, 1);
+    EXPECT_EQ(dispatcher_.ProcessQueue(), 1);
+    EXPECT_EQ(call.get(), "world");
+    EXPECT_EQ(lane.ExecutedCount(), 1U);
+}
+
+TEST_F(DispatchLaneTest, RunsInlineWhenAlreadyOnTheDispatcherThread) {
+    DispatchLane lane(dispatcher_, 0);
+    EXPECT_EQ(lane.Run([]() { return std::string("inline"); }, In(std::chrono::seconds(5))), "inline");
+    EXPECT_EQ(dispatcher_.GetPendingCount(), 0U);
+}
+
+TEST_F(DispatchLaneTest, BudgetDefersTheRestToTheNextFrame) {
+    DispatchLane lane(dispatcher_, 2);
+    std::atomic<int> ran{0};
+    std::vector<std::future<std::string>> calls;
+    for (int i = 0; i < 5; i++) {
+        calls.push_back(std::async(std::launch::async, [&, i]() {
+            return lane.Run(
+                [&, i]() {
+                    ran++;
+                    return std::to_string(i);
+                },
+                In(std::chrono::seconds(5)));
+        }));
+    }
+    WaitForPending(lane, 5);
+
+    dispatcher_.ProcessQueue();
+    EXPECT_EQ(ran, 2);
+    dispatcher_.ProcessQueue();
+    EXPECT_EQ(ran, 4);
+    dispatcher_.ProcessQueue();
+    EXPECT_EQ(ran, 5);
+
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(calls[i].get(), std::to_string(i));
+    }
+}
+
+TEST_F(DispatchLaneTest, CallsArrivingDuringAFrameShareItsBudget) {
+    DispatchLane lane(dispatcher_, 2);
+    std::atomic<int> ran{0};
+    std::atomic<bool> spawned{false};
+    std::future<std::string> late;
+    std::function<std::future<std::string>(int)> call = [&](int i) {
+        return std::async(std::launch::async, [&, i]() {
+            return lane.Run(
+                [&, i]() {
+                    ran++;
+                    // The first handler of the frame sees another call arrive after its batch emptied the lane
+                    if (!spawned.exchange(true)) {
+                        late = call(2);
+                        WaitForPending(lane, 1);
+                    }
+                    return std::to_string(i);
+                },
+                In(std::chrono::seconds(5)));
+        });
+    };
+    auto first = call(0);
+    auto second = call(1);
+    WaitForPending(lane, 2);
+
+    dispatcher_.ProcessQueue();
+    EXPECT_EQ(ran, 2);
+    dispatcher_.ProcessQueue();
+    EXPECT_EQ(ran, 3);
+
+    EXPECT_EQ(first.get(), "0");
+    EXPECT_EQ(second.get(), "1");
+    EXPECT_EQ(late.get(), "2");
+}
+
+TEST_F(DispatchLaneTest, RejectsCallsThatMissTheirDeadline) {
+    DispatchLane lane(dispatcher_, 0);
+    std::atomic<bool> ran{false};
+
+    auto call = std::async(std::launch::async, [&]() {
+        return lane.Run(
+            [&]() {
+                ran = true;
+                return std::string();
+            },
+            In(std::chrono::milliseconds(20)));
+    });
+    EXPECT_THROW(call.get(), std::runtime_error);  // No frame ran in time
+    EXPECT_EQ(lane.RejectedCount(), 1U);
+
+    dispatcher_.ProcessQueue();
+    EXPECT_FALSE(ran);
+    EXPECT_EQ(lane.ExecutedCount(), 0U);
+}
+
+TEST_F(DispatchLaneTest, PropagatesHandlerExceptions) {
+    DispatchLane lane(dispatcher_, 0);
+    auto call = std::async(std::launch::async, [&]() {
+        return lane.Run([]() -> std::string { throw std::runtime_error("player not found"); },
+                        In(std::chrono::seconds(5)));
+    });
+    WaitForPending(lane, 1);
+    dispatcher_.ProcessQueue();
+
+    try {
+        call.get();
+        FAIL() << "expected the handler's exception";
+    } catch (const std::runtime_error& e) {
+        EXPECT_STREQ(e.what(), "player not found");
+    }
+}
+
+TEST(FunctionTableDispatchTest, CopiesDispatcherFromDescriptors) {
+    Dispatcher world;
+    FunctionDescriptor kick;
+    kick.id = "player.kick";
+    kick.dispatcher = &world;
+    kick.dispatch_deadline_ms = 250;
+    FunctionTable table({{"player.kick", [](const std::string&, const std::string&) { return std::string(); }}}, {},
+                        {{"player.kick", kick}});
+
+    EXPECT_EQ(table.Find("player.kick")->dispatcher, &world);
+    EXPECT_EQ(table.Find("player.kick")->dispatch_deadline_ms, 250);
+}
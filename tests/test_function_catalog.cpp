@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/registry/function_catalog.h"
+
+using namespace croupier::sdk;
+using namespace croupier::sdk::registry;
+
+namespace {
+
+FunctionDescriptor MakeFunction(const std::string& id, const std::string& version = "1.0.0") {
+    FunctionDescriptor desc;
+    desc.id = id;
+    desc.version = version;
+    return desc;
+}
+
+}  // namespace
+
+TEST(FunctionCatalogTest, FingerprintCoversDescriptorFields) {
+    FunctionDescriptor base = MakeFunction("wallet.get");
+    const uint64_t fingerprint = FunctionCatalog::Fingerprint(base);
+    EXPECT_EQ(fingerprint, FunctionCatalog::Fingerprint(MakeFunction("wallet.get")));
+
+    FunctionDescriptor versioned = base;
+    versioned.version = "1.0.1";
+    EXPECT_NE(fingerprint, FunctionCatalog::Fingerprint(versioned));
+
+    FunctionDescriptor schema = base;
+    schema.input_schema = R"({"type":"object"})";
+    EXPECT_NE(fingerprint, FunctionCatalog::Fingerprint(schema));
+
+    FunctionDescriptor split_a = base;
+    FunctionDescriptor split_b = base;
+    split_a.tags = {"ab", "c"};
+    split_b.tags = {"a", "bc"};
+    EXPECT_NE(FunctionCatalog::Fingerprint(split_a), FunctionCatalog::Fingerprint(split_b));
+}
+
+TEST(FunctionCatalogTest, HashIgnoresRegistrationOrder) {
+    FunctionCatalog forward;
+    forward.Set(MakeFunction("a.first"));
+    forward.Set(MakeFunction("b.second"));
+
+    FunctionCatalog reverse;
+    reverse.Set(MakeFunction("b.second"));
+    reverse.Set(MakeFunction("a.first"));
+    EXPECT_EQ(forward.Hash(), reverse.Hash());
+
+    reverse.Set(MakeFunction("b.second", "2.0.0"));
+    EXPECT_NE(forward.Hash(), reverse.Hash());
+
+    reverse.Remove("b.second");
+    EXPECT_NE(forward.Hash(), reverse.Hash());
+    EXPECT_EQ(reverse.Size(), 1U);
+}
+
+TEST(FunctionCatalogTest, DiffNamesAddedChangedAndRemoved) {
+    FunctionCatalog acknowledged;
+    acknowledged.Set(MakeFunction("item.grant"));
+    acknowledged.Set(MakeFunction("player.ban"));
+    acknowledged.Set(MakeFunction("wallet.get"));
+
+    FunctionCatalog current = acknowledged;
+    EXPECT_TRUE(current.Diff(acknowledged).Empty());
+
+    current.Remove("item.grant");
+    current.Set(MakeFunction("player.ban", "1.1.0"));
+    current.Set(MakeFunction("zone.enter"));
+
+    const CatalogDelta delta = current.Diff(acknowledged);
+    EXPECT_EQ(delta.added, std::vector<std::string>{"zone.enter"});
+    EXPECT_EQ(delta.changed, std::vector<std::string>{"player.ban"});
+    EXPECT_EQ(delta.removed, std::vector<std::string>{"item.grant"});
+}
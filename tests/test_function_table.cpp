@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/dispatch/function_table.h"
+
+using namespace croupier::sdk;
+using namespace croupier::sdk::dispatch;
+
+namespace {
+
+FunctionHandler Returning(const std::string& value) {
+    return [value](const std::string&, const std::string&) { return value; };
+}
+
+}  // namespace
+
+TEST(FunctionTableTest, FindsHandlersByNameAndHandle) {
+    std::map<std::string, FunctionHandler> handlers = {
+        {"wallet.get", Returning("get")}, {"player.ban", Returning("ban")}, {"item.grant", Returning("grant")}};
+    FunctionTable table(handlers);
+
+    ASSERT_EQ(table.Size(), 3U);
+    const auto* ban = table.Find("player.ban");
+    ASSERT_NE(ban, nullptr);
+    EXPECT_EQ(ban->handler("", ""), "ban");
+
+    // Handles follow function ID order
+    EXPECT_EQ(table.HandleOf("item.grant"), 1U);
+    EXPECT_EQ(table.HandleOf("player.ban"), 2U);
+    EXPECT_EQ(table.HandleOf("wallet.get"), 3U);
+    EXPECT_EQ(table.Get(3)->function_id, "wallet.get");
+}
+
+TEST(FunctionTableTest, MissingFunctionsAndHandles) {
+    FunctionTable empty;
+    EXPECT_EQ(empty.Find("wallet.get"), nullptr);
+    EXPECT_EQ(empty.Get(1), nullptr);
+
+    FunctionTable table({{"wallet.get", Returning("get")}});
+    EXPECT_EQ(table.Find("wallet.gets"), nullptr);
+    EXPECT_EQ(table.Find(""), nullptr);
+    EXPECT_EQ(table.HandleOf("wallet.put"), 0U);
+    EXPECT_EQ(table.Get(0), nullptr);
+    EXPECT_EQ(table.Get(2), nullptr);
+}
+
+TEST(FunctionTableTest, ResolvesLargeRegistrations) {
+    std::map<std::string, FunctionHandler> handlers;
+    for (int i = 0; i < 20000; ++i) {
+        handlers.emplace("game.function." + std::to_string(i), Returning(std::to_string(i)));
+    }
+    FunctionTable table(handlers);
+
+    for (int i = 0; i < 20000; i += 97) {
+        const auto* entry = table.Find("game.function." + std::to_string(i));
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->handler("", ""), std::to_string(i));
+        EXPECT_EQ(table.Get(table.HandleOf(entry->function_id)), entry);
+    }
+    EXPECT_EQ(table.Find("game.function.20000"), nullptr);
+}
+
+TEST(FunctionTableTest, MergesZeroCopyHandlersInIdOrder) {
+    std::map<std::string, FunctionHandler> handlers = {{"a.string", Returning("a")}, {"c.string", Returning("c")}};
+    std::map<std::string, FunctionViewHandler> view_handlers = {
+        {"b.view", [](const CallMetadata&, std::string_view payload, ResponseWriter& out) { out.Append(payload); }}};
+    FunctionTable table(handlers, view_handlers);
+
+    ASSERT_EQ(table.Size(), 3U);
+    EXPECT_EQ(table.HandleOf("b.view"), 2U);
+    const auto* view = table.Find("b.view");
+    ASSERT_NE(view, nullptr);
+    EXPECT_FALSE(view->handler);
+    ASSERT_TRUE(view->view_handler);
+
+    struct NoMetadata : CallMetadata {
+        std::optional<std::string_view> Get(std::string_view) const override { return std::nullopt; }
+        const std::string& Json() const override { return json; }
+        std::string json = "{}";
+    } metadata;
+    std::string buffer = "prefix:";
+    ResponseWriter out(buffer);
+    view->view_handler(metadata, "payload", out);
+    EXPECT_EQ(buffer, "prefix:payload");
+    EXPECT_TRUE(table.Find("c.string")->handler);
+}
+
+TEST(FunctionTableTest, CopiesCachePolicyFromDescriptors) {
+    FunctionDescriptor items;
+    items.id = "config.items";
+    items.cache_ttl_ms = 30000;
+    FunctionTable table({{"config.items", Returning("[]")}, {"wallet.credit", Returning("{}")}}, {},
+                        {{"config.items", items}});
+
+    EXPECT_EQ(table.Find("config.items")->cache_ttl_ms, 30000);
+    EXPECT_EQ(table.Find("wallet.credit")->cache_ttl_ms, 0);
+}
+
+TEST(FunctionTableTest, RebuildKeepsHandlesOfSurvivingFunctions) {
+    FunctionTable first({{"b.second", Returning("b")}, {"c.third", Returning("c")}});
+    ASSERT_EQ(first.HandleOf("c.third"), 2U);
+
+    // Remove b.second, add a.first: c.third keeps handle 2 and a.first is appended
+    FunctionTable second({{"a.first", Returning("a")}, {"c.third", Returning("c")}}, {}, {}, &first);
+    EXPECT_EQ(second.Size(), 2U);
+    EXPECT_EQ(second.HandleOf("c.third"), 2U);
+    EXPECT_EQ(second.HandleOf("a.first"), 3U);
+    EXPECT_EQ(second.Get(1), nullptr);
+    EXPECT_EQ(second.Find("b.second"), nullptr);
+    EXPECT_FALSE(second.Entries()[0].Live());
+
+    // Re-registering a removed function reclaims its old handle
+    FunctionTable third({{"a.first", Returning("a")}, {"b.second", Returning("b2")}, {"c.third", Returning("c")}}, {},
+                        {}, &second);
+    EXPECT_EQ(third.HandleOf("b.second"), 1U);
+    EXPECT_EQ(third.Get(1)->handler("", ""), "b2");
+    EXPECT_EQ(third.Entries().size(), 3U);
+}
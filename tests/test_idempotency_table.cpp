@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/cache/idempotency_table.h"
+#include "test_clock.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace croupier::sdk;
+using namespace croupier::sdk::cache;
+using croupier::sdk::test::At;
+
+TEST(IdempotencyTableTest, RetriedKeyReplaysFirstResponse) {
+    IdempotencyTable table{IdempotencyConfig()};
+    int executions = 0;
+    auto credit = [&]() { return "balance=" + std::to_string(100 + 10 * ++executions); };
+
+    const std::string key = IdempotencyTable::MakeKey("wallet.credit", "req-1");
+    bool deduplicated = true;
+    EXPECT_EQ(table.Execute(key, credit, &deduplicated, At(0)), "balance=110");
+    EXPECT_FALSE(deduplicated);
+    EXPECT_EQ(table.Execute(key, credit, &deduplicated, At(10)), "balance=110");
+    EXPECT_TRUE(deduplicated);
+    EXPECT_EQ(executions, 1);
+
+    // Same idempotency key on another function is a different call
+    EXPECT_EQ(table.Execute(IdempotencyTable::MakeKey("wallet.debit", "req-1"), credit, nullptr, At(10)),
+              "balance=120");
+
+    auto stats = table.GetStats();
+    EXPECT_EQ(stats.executions, 2U);
+    EXPECT_EQ(stats.replays, 1U);
+}
+
+TEST(IdempotencyTableTest, ConcurrentRetriesJoinInFlightExecution) {
+    IdempotencyTable table{IdempotencyConfig()};
+    std::atomic<int> executions{0};
+    std::atomic<bool> release{false};
+    auto slow = [&]() {
+        executions++;
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return std::string("done");
+    };
+
+    std::vector<std::thread> callers;
+    std::vector<std::string> results(4);
+    for (size_t i = 0; i < results.size(); ++i) {
+        callers.emplace_back([&, i]() { results[i] = table.Execute("wallet.credit\x1freq-2", slow); });
+    }
+    while (executions == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    release = true;
+    for (auto& caller : callers) {
+        caller.join();
+    }
+
+    EXPECT_EQ(executions.load(), 1);
+    EXPECT_EQ(table.GetStats().joins, 3U);
+    for (const auto& result : results) {
+        EXPECT_EQ(result, "done");
+    }
+}
+
+TEST(IdempotencyTableTest, FailuresAreNotRemembered) {
+    IdempotencyTable table{IdempotencyConfig()};
+    int executions = 0;
+    auto flaky = [&]() -> std::string {
+        if (++executions == 1) {
+            throw std::runtime_error("db unavailable");
+        }
+        return "ok";
+    };
+
+    EXPECT_THROW(table.Execute("key", flaky, nullptr, At(0)), std::runtime_error);
+    EXPECT_EQ(table.Execute("key", flaky, nullptr, At(1)), "ok");
+    EXPECT_EQ(executions, 2);
+}
+
+TEST(IdempotencyTableTest, EntriesExpireAfterTTL) {
+    IdempotencyConfig config;
+    config.ttl_ms = 1000;
+    IdempotencyTable table(config);
+    int executions = 0;
+    auto run = [&]() { return std::to_string(++executions); };
+
+    EXPECT_EQ(table.Execute("key", run, nullptr, At(0)), "1");
+    EXPECT_EQ(table.Execute("key", run, nullptr, At(999)), "1");
+    EXPECT_EQ(table.Execute("key", run, nullptr, At(1000)), "2");
+}
+
+TEST(IdempotencyTableTest, BoundedByMaxEntries) {
+    IdempotencyConfig config;
+    config.max_entries = 2;
+    config.shards = 1;
+    IdempotencyTable table(config);
+    auto run = []() { return std::string("v"); };
+
+    table.Execute("a", run, nullptr, At(0));
+    table.Execute("b", run, nullptr, At(1));
+    table.Execute("c", run, nullptr, At(2));
+    EXPECT_EQ(table.Size(), 2U);
+    EXPECT_EQ(table.GetStats().evictions, 1U);
+
+    bool deduplicated = false;
+    table.Execute("a", run, &deduplicated, At(3));  // Oldest key was evicted
+    EXPECT_FALSE(deduplicated);
+}
+
+TEST(IdempotencyTableTest, OversizedResponsesAreNotStored) {
+    IdempotencyConfig config;
+    config.max_response_bytes = 4;
+    IdempotencyTable table(config);
+    int executions = 0;
+    auto run = [&]() {
+        ++executions;
+        return std::string("0123456789");
+    };
+
+    table.Execute("key", run, nullptr, At(0));
+    table.Execute("key", run, nullptr, At(1));
+    EXPECT_EQ(executions, 2);
+}
+
+TEST(IdempotencyTableTest, DisabledTableAlwaysExecutes) {
+    IdempotencyConfig config;
+    config.enabled = false;
+    IdempotencyTable table(config);
+    int executions = 0;
+    auto run = [&]() { return std::to_string(++executions); };
+
+    EXPECT_FALSE(table.Enabled());
+    EXPECT_EQ(table.Execute("key", run), "1");
+    EXPECT_EQ(table.Execute("key", run), "2");
+}
@@ -1,6 +1,13 @@
 #include <gtest/gtest.h>
 
 #include "croupier/sdk/croupier_client.h"
+#include "croupier/sdk/runtime.h"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
 
 using namespace croupier::sdk;
 
@@ -15,6 +22,14 @@ InvokerConfig MakeConfig() {
     return config;
 }
 
+// The per-call lines these tests look for are DEBUG lines written to stdout
+InvokerConfig MakeDebugConfig() {
+    InvokerConfig config = MakeConfig();
+    config.disable_logging = false;
+    config.debug_logging = true;
+    return config;
+}
+
 }  // namespace
 
 TEST(InvokerFallbackTest, ConnectUsesFallbackBehaviorWithoutTCP) {
@@ -79,3 +94,119 @@ TEST(InvokerFallbackTest, CancelJobUsesFallbackBehaviorWithoutTCP) {
     EXPECT_TRUE(invoker.CancelJob(job_id));
 #endif
 }
+
+TEST(InvokerFallbackTest, TryInvokeReturnsValueWithoutThrowing) {
+    CroupierInvoker invoker(MakeConfig());
+
+#ifdef CROUPIER_SDK_HAS_TCP
+    SUCCEED();
+#else
+    ASSERT_TRUE(invoker.Connect());
+    auto result = invoker.TryInvoke("player.echo", R"({"ok":true})");
+    ASSERT_TRUE(result.ok());
+    EXPECT_NE(result.value().find("\"function_id\":\"player.echo\""), std::string::npos);
+#endif
+}
+
+TEST(InvokerFallbackTest, TryInvokeReportsUnavailableWhenNotConnected) {
+    InvokerConfig config = MakeConfig();
+    config.address.clear();
+    CroupierInvoker disconnected(config);
+    ReconnectConfig no_reconnect;
+    no_reconnect.enabled = false;
+    disconnected.SetReconnectConfig(no_reconnect);
+
+    auto unavailable = disconnected.TryInvoke("player.echo", "{}");
+    ASSERT_FALSE(unavailable.ok());
+    EXPECT_EQ(unavailable.error().code, StatusCode::UNAVAILABLE);
+    EXPECT_EQ(unavailable.error().Code(), 14);
+    EXPECT_THROW(disconnected.Invoke("player.echo", "{}"), std::runtime_error);
+}
+
+TEST(InvokerFallbackTest, CachedReadsAreInvalidatedByMutations) {
+    InvokerConfig config = MakeDebugConfig();
+    config.cache.enabled = true;
+    CroupierInvoker invoker(config);
+
+    VirtualObjectDescriptor wallet;
+    wallet.id = "wallet.entity";
+    wallet.operations = {{"read", "wallet.get"}, {"update", "wallet.credit"}};
+    wallet.metadata["cache_ttl_ms"] = "60000";
+    invoker.SetObjectDescriptor(wallet);
+
+#ifdef CROUPIER_SDK_HAS_TCP
+    SUCCEED();
+#else
+    ASSERT_TRUE(invoker.Connect());
+    const std::string first = invoker.Invoke("wallet.get", R"({"id":1})");
+
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(invoker.Invoke("wallet.get", R"({"id":1})"), first);
+    EXPECT_EQ(testing::internal::GetCapturedStdout().find("Invoking function"), std::string::npos);
+
+    invoker.Invoke("wallet.credit", R"({"id":1,"amount":5})");
+    testing::internal::CaptureStdout();
+    EXPECT_EQ(invoker.Invoke("wallet.get", R"({"id":1})"), first);
+    EXPECT_NE(testing::internal::GetCapturedStdout().find("Invoking function: wallet.get"), std::string::npos);
+#endif
+}
+
+TEST(InvokerFallbackTest, ConcurrentStreamJobCallsWaitWithoutPolling) {
+    CroupierInvoker invoker(MakeDebugConfig());
+
+#ifdef CROUPIER_SDK_HAS_TCP
+    SUCCEED();
+#else
+    ASSERT_TRUE(invoker.Connect());
+    const std::string job_id = invoker.StartJob("player.batch", "{}");
+
+    testing::internal::CaptureStdout();
+    auto first = invoker.StreamJob(job_id);
+    auto second = invoker.StreamJob(job_id);
+    const auto first_events = first.get();
+    const auto second_events = second.get();
+    const std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(first_events.size(), second_events.size());
+    EXPECT_TRUE(second_events.back().done);
+    // The job's terminal event completes both callers; no poller is started for a local job
+    EXPECT_EQ(output.find("Streaming job events for: " + job_id), std::string::npos);
+    const std::string marker = "Subscribing to local job events for: " + job_id;
+    const auto first_subscription = output.find(marker);
+    ASSERT_NE(first_subscription, std::string::npos);
+    EXPECT_NE(output.find(marker, first_subscription + 1), std::string::npos);
+#endif
+}
+
+TEST(InvokerFallbackTest, LocalJobsDoNotHoldSharedRuntimeWorkers) {
+    RuntimeConfig runtime_config;
+    runtime_config.worker_threads = 1;
+    auto runtime = std::make_shared<Runtime>(runtime_config);
+    InvokerConfig config = MakeConfig();
+    config.runtime = runtime;
+    CroupierInvoker invoker(config);
+
+#ifdef CROUPIER_SDK_HAS_TCP
+    SUCCEED();
+#else
+    ASSERT_TRUE(invoker.Connect());
+    std::vector<std::string> job_ids;
+    for (int i = 0; i < 8; i++) {
+        job_ids.push_back(invoker.StartJob("player.batch", "{}"));
+    }
+
+    // The only worker is free between job steps, so other users of the runtime are not held up behind the jobs
+    std::promise<void> ran;
+    const auto posted = std::chrono::steady_clock::now();
+    runtime->Post([&ran]() { ran.set_value(); });
+    ran.get_future().wait();
+    EXPECT_LT(std::chrono::steady_clock::now() - posted, std::chrono::milliseconds(80));
+
+    for (const auto& job_id : job_ids) {
+        const auto events = invoker.StreamJob(job_id).get();
+        ASSERT_FALSE(events.empty());
+        EXPECT_TRUE(events.back().done);
+    }
+    invoker.Close();
+#endif
+}
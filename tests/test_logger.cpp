@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace croupier::sdk;
+
+namespace {
+
+// Collects everything the logger writes
+struct CapturedOutput {
+    std::mutex mutex;
+    std::string text;
+
+    Logger::Sink Sink() {
+        return [this](const char* data, size_t size) {
+            std::lock_guard<std::mutex> lock(mutex);
+            text.append(data, size);
+        };
+    }
+
+    size_t Count(const std::string& needle) {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t count = 0;
+        for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+            count++;
+        }
+        return count;
+    }
+};
+
+}  // namespace
+
+class LoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        logger_.SetSink(output_.Sink());
+        logger_.SetLevel(Logger::Level::INFO);
+    }
+
+    void TearDown() override {
+        logger_.StopAsync();
+        logger_.SetSink(nullptr);
+        logger_.SetLevel(Logger::Level::INFO);
+        logger_.SetTraceSampleRate(1.0);
+    }
+
+    Logger& logger_ = Logger::GetInstance();
+    CapturedOutput output_;
+};
+
+TEST_F(LoggerTest, WritesFormattedLinesSynchronously) {
+    logger_.Info("wallet", "balance loaded");
+    logger_.Debug("wallet", "filtered out");
+
+    ASSERT_EQ(output_.Count("\n"), 1U);
+    const std::string& line = output_.text;
+    EXPECT_NE(line.find(" [INFO] [wallet] balance loaded\n"), std::string::npos);
+    // 2025-01-02T03:04:05.678Z
+    ASSERT_GE(line.size(), 24U);
+    EXPECT_EQ(line[4], '-');
+    EXPECT_EQ(line[10], 'T');
+    EXPECT_EQ(line[19], '.');
+    EXPECT_EQ(line[23], 'Z');
+}
+
+TEST_F(LoggerTest, AsyncWritesEveryLineAfterFlush) {
+    logger_.StartAsync();
+    EXPECT_TRUE(logger_.IsAsync());
+    const uint64_t dropped_before = logger_.DroppedCount();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([this, t]() {
+            for (int i = 0; i < 250; i++) {
+                logger_.Info("match", "tick " + std::to_string(t) + "/" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    logger_.Flush();
+
+    EXPECT_EQ(output_.Count("[INFO] [match] tick "), 1000U);
+    EXPECT_EQ(output_.Count("tick 3/249\n"), 1U);
+    EXPECT_EQ(logger_.DroppedCount(), dropped_before);
+}
+
+TEST_F(LoggerTest, StopAsyncReturnsToSynchronousWriting) {
+    logger_.StartAsync();
+    logger_.Warn("lobby", "queued");
+    logger_.StopAsync();
+    EXPECT_FALSE(logger_.IsAsync());
+    EXPECT_EQ(output_.Count("[WARN] [lobby] queued\n"), 1U);
+
+    logger_.Warn("lobby", "direct");
+    EXPECT_EQ(output_.Count("[WARN] [lobby] direct\n"), 1U);
+}
+
+TEST_F(LoggerTest, DropPolicyCountsAndReportsDiscardedLines) {
+    std::atomic<bool> release{false};
+    logger_.SetSink([this, &release](const char* data, size_t size) {
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::lock_guard<std::mutex> lock(output_.mutex);
+        output_.text.append(data, size);
+    });
+    AsyncLogConfig config;
+    config.queue_capacity = 4;
+    config.overflow = LogOverflow::DROP;
+    logger_.StartAsync(config);
+
+    const uint64_t dropped_before = logger_.DroppedCount();
+    for (int i = 0; i < 100; i++) {
+        logger_.Info("spam", "line " + std::to_string(i));
+    }
+    const uint64_t dropped = logger_.DroppedCount() - dropped_before;
+    EXPECT_GT(dropped, 0U);
+
+    release = true;
+    logger_.Flush();
+    logger_.StopAsync();
+    EXPECT_EQ(output_.Count("[INFO] [spam] line "), 100U - dropped);
+    EXPECT_GE(output_.Count("[WARN] [logger] dropped "), 1U);
+}
+
+TEST_F(LoggerTest, BlockPolicyKeepsEveryLine) {
+    logger_.SetSink([this](const char* data, size_t size) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        std::lock_guard<std::mutex> lock(output_.mutex);
+        output_.text.append(data, size);
+    });
+    AsyncLogConfig config;
+    config.queue_capacity = 4;
+    config.overflow = LogOverflow::BLOCK;
+    logger_.StartAsync(config);
+
+    const uint64_t dropped_before = logger_.DroppedCount();
+    for (int i = 0; i < 200; i++) {
+        logger_.Info("ledger", "entry " + std::to_string(i));
+    }
+    logger_.Flush();
+
+    EXPECT_EQ(output_.Count("[INFO] [ledger] entry "), 200U);
+    EXPECT_EQ(logger_.DroppedCount(), dropped_before);
+}
+
+TEST_F(LoggerTest, FlushSurvivesConcurrentRestarts) {
+    logger_.StartAsync();
+    std::atomic<bool> done{false};
+    std::vector<std::thread> flushers;
+    for (int t = 0; t < 2; t++) {
+        flushers.emplace_back([this, &done]() {
+            while (!done.load()) {
+                logger_.Info("match", "flush");
+                logger_.Flush();
+            }
+        });
+    }
+    // Each restart replaces the queue a concurrent Flush may still be waiting on
+    for (int i = 0; i < 50; i++) {
+        logger_.StopAsync();
+        logger_.StartAsync();
+    }
+    done = true;
+    for (auto& thread : flushers) {
+        thread.join();
+    }
+    logger_.Flush();
+    EXPECT_GT(output_.Count("[INFO] [match] flush\n"), 0U);
+}
+
+TEST(LogSiteLimiterTest, SuppressesPastTheLimitAndReportsTheCount) {
+    LogSiteLimiter site;
+    uint64_t suppressed = 0;
+    int passed = 0;
+    for (int i = 0; i < 50; i++) {
+        if (site.Allow(10, suppressed)) {
+            passed++;
+        }
+    }
+    // All 50 calls normally land in one window; a window boundary can let another 10 through
+    EXPECT_GE(passed, 10);
+    EXPECT_LE(passed, 20);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    ASSERT_TRUE(site.Allow(10, suppressed));
+    EXPECT_EQ(suppressed, static_cast<uint64_t>(50 - passed));
+    ASSERT_TRUE(site.Allow(10, suppressed));
+    EXPECT_EQ(suppressed, 0U);
+}
+
+TEST(LogSiteLimiterTest, ZeroMeansUnlimited) {
+    LogSiteLimiter site;
+    uint64_t suppressed = 0;
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_TRUE(site.Allow(0, suppressed));
+    }
+}
+
+TEST_F(LoggerTest, TraceSamplingKeepsWholeTraces) {
+    logger_.SetTraceSampleRate(0.25);
+    int sampled = 0;
+    for (int i = 0; i < 4000; i++) {
+        const std::string trace_id = "trace-" + std::to_string(i);
+        const bool first = logger_.IsTraceSampled(trace_id);
+        EXPECT_EQ(first, logger_.IsTraceSampled(trace_id));
+        sampled += first ? 1 : 0;
+    }
+    EXPECT_GT(sampled, 800);
+    EXPECT_LT(sampled, 1200);
+    EXPECT_TRUE(logger_.IsTraceSampled(""));  // Untagged lines are never sampled out
+
+    logger_.SetTraceSampleRate(0.0);
+    EXPECT_FALSE(logger_.IsTraceSampled("trace-1"));
+    logger_.SetTraceSampleRate(1.0);
+    EXPECT_TRUE(logger_.IsTraceSampled("trace-1"));
+}
+
+TEST(LoggerCompileTimeLevelTest, FollowsTheBuildMinimum) {
+    static_assert(Logger::IsCompiledIn(Logger::Level::OFF), "IsCompiledIn must be usable at compile time");
+    EXPECT_EQ(Logger::IsCompiledIn(Logger::Level::DEBUG), CROUPIER_LOG_MIN_LEVEL <= 0);
+    EXPECT_EQ(Logger::IsCompiledIn(Logger::Level::WARN), CROUPIER_LOG_MIN_LEVEL <= 2);
+}
+
+TEST(JsonMaskerTest, MasksStringValuesOfListedKeys) {
+    JsonMasker masker({"password", "token"});
+    EXPECT_EQ(masker.Mask(R"({"user":"alice","password":"hunter2","token" : "abc","level":3})"),
+              R"({"user":"alice","password":"***masked***","token":"***masked***","level":3})");
+}
+
+TEST(JsonMaskerTest, MasksNestedKeysAndLeavesOthersAlone) {
+    JsonMasker masker({"secret"});
+    EXPECT_EQ(masker.Mask(R"({"auth":{"secret":"s3","scope":"read"},"items":[{"secret":"x"}]})"),
+              R"({"auth":{"secret":"***masked***","scope":"read"},"items":[{"secret":"***masked***"}]})");
+    EXPECT_EQ(masker.Mask(R"({"secrets":"a","secret_id":"b","secret":""})"),
+              R"({"secrets":"a","secret_id":"b","secret":""})");
+}
+
+TEST(JsonMaskerTest, TokenizesStringsWithEscapesAndLookalikes) {
+    JsonMasker masker({"password"});
+    // Escaped quotes stay inside the masked value; a value that merely mentions the key is not a key
+    EXPECT_EQ(masker.Mask(R"({"password":"a\"b\\","note":"\"password\":\"keep\""})"),
+              R"({"password":"***masked***","note":"\"password\":\"keep\""})");
+    EXPECT_EQ(masker.Mask(R"({"password":"unterminated)"), R"({"password":"unterminated)");
+}
+
+TEST(JsonMaskerTest, EmptyKeyListCopiesInput) {
+    JsonMasker masker({});
+    const std::string json = R"({"password":"hunter2"})";
+    EXPECT_EQ(masker.Mask(json), json);
+
+    std::string out = "prefix ";
+    JsonMasker({"password"}).MaskInto(json, out);
+    EXPECT_EQ(out, R"(prefix {"password":"***masked***"})");
+}
+
+TEST(JsonMaskerTest, MaskJsonSensitiveKeepsItsOutputFormat) {
+    EXPECT_EQ(MaskJsonSensitive(R"({"api_key" :  "k-123", "name":"bot"})", {"api_key"}),
+              R"({"api_key":"***masked***", "name":"bot"})");
+}
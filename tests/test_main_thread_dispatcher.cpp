@@ -13,13 +13,21 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <future>
+#include <memory>
+#include <string>
 #include <thread>
 #include <vector>
 
 #include "croupier/sdk/threading/main_thread_dispatcher.h"
 
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
 using namespace croupier::sdk::threading;
 
 class MainThreadDispatcherTest : public ::testing::Test {
@@ -226,6 +234,233 @@ TEST_F(MainThreadDispatcherTest, ConcurrentEnqueue_IsThreadSafe) {
     EXPECT_EQ(thread_count * enqueues_per_thread, total_processed);
 }
 
+TEST_F(MainThreadDispatcherTest, ProcessQueue_PreservesOrderAcrossPartialBatches) {
+    std::vector<int> order;
+    auto enqueue_range = [&order](int from, int to) {
+        std::async(std::launch::async, [&order, from, to]() {
+            for (int i = from; i < to; i++) {
+                MainThreadDispatcher::GetInstance().Enqueue([&order, i]() { order.push_back(i); });
+            }
+        }).wait();
+    };
+
+    enqueue_range(0, 5);
+    EXPECT_EQ(3, MainThreadDispatcher::GetInstance().ProcessQueue(3));
+    enqueue_range(5, 8);  // Queued behind the two callbacks left in the claimed batch
+    EXPECT_EQ(5U, MainThreadDispatcher::GetInstance().GetPendingCount());
+    EXPECT_EQ(5, MainThreadDispatcher::GetInstance().ProcessQueue(10));
+
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}), order);
+    EXPECT_EQ(0U, MainThreadDispatcher::GetInstance().GetPendingCount());
+}
+
+TEST_F(MainThreadDispatcherTest, Enqueue_AcceptsMoveOnlyCallback) {
+    int value = 0;
+    auto payload = std::make_unique<int>(42);
+    std::async(std::launch::async, [&value, &payload]() {
+        MainThreadDispatcher::GetInstance().Enqueue(
+            [&value, payload = std::move(payload)]() { value = *payload; });
+    }).wait();
+
+    EXPECT_EQ(1, MainThreadDispatcher::GetInstance().ProcessQueue());
+    EXPECT_EQ(42, value);
+}
+
+TEST_F(MainThreadDispatcherTest, ProcessQueue_RunsCriticalLaneFirst) {
+    std::vector<std::string> order;
+    std::async(std::launch::async, [&order]() {
+        auto& dispatcher = MainThreadDispatcher::GetInstance();
+        dispatcher.Enqueue([&order]() { order.push_back("metrics"); }, MainThreadDispatcher::Priority::BACKGROUND);
+        dispatcher.Enqueue([&order]() { order.push_back("completion-1"); });
+        dispatcher.Enqueue([&order]() { order.push_back("log"); }, MainThreadDispatcher::Priority::BACKGROUND);
+        dispatcher.Enqueue([&order]() { order.push_back("completion-2"); }, MainThreadDispatcher::Priority::CRITICAL);
+    }).wait();
+
+    EXPECT_EQ(4, MainThreadDispatcher::GetInstance().ProcessQueue());
+    EXPECT_EQ((std::vector<std::string>{"completion-1", "completion-2", "metrics", "log"}), order);
+}
+
+TEST_F(MainThreadDispatcherTest, ProcessQueueFor_StopsWhenBudgetIsUsed) {
+    std::async(std::launch::async, []() {
+        for (int i = 0; i < 10; i++) {
+            MainThreadDispatcher::GetInstance().Enqueue(
+                []() { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+        }
+    }).wait();
+
+    const int processed = MainThreadDispatcher::GetInstance().ProcessQueueFor(std::chrono::milliseconds(12));
+    EXPECT_GE(processed, 1);
+    EXPECT_LT(processed, 10);
+    EXPECT_EQ(static_cast<size_t>(10 - processed), MainThreadDispatcher::GetInstance().GetPendingCount());
+
+    // A zero budget still makes progress
+    EXPECT_EQ(1, MainThreadDispatcher::GetInstance().ProcessQueueFor(std::chrono::microseconds(0)));
+    MainThreadDispatcher::GetInstance().Clear();
+}
+
+TEST_F(MainThreadDispatcherTest, GetStats_ReportsLatencyAndHighWater) {
+    std::async(std::launch::async, []() {
+        for (int i = 0; i < 3; i++) {
+            MainThreadDispatcher::GetInstance().Enqueue([]() {});
+        }
+        MainThreadDispatcher::GetInstance().Enqueue([]() {}, MainThreadDispatcher::Priority::BACKGROUND);
+    }).wait();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    MainThreadDispatcher::GetInstance().ProcessQueue();
+
+    const auto stats = MainThreadDispatcher::GetInstance().GetStats();
+    EXPECT_EQ(3U, stats.critical.executed);
+    EXPECT_EQ(1U, stats.background.executed);
+    EXPECT_GE(stats.critical.max_latency, std::chrono::milliseconds(2));
+    EXPECT_GE(stats.critical.AverageLatency(), std::chrono::milliseconds(2));
+    EXPECT_EQ(4U, stats.pending_high_water);
+
+    MainThreadDispatcher::GetInstance().ResetStats();
+    EXPECT_EQ(0U, MainThreadDispatcher::GetInstance().GetStats().critical.executed);
+    EXPECT_EQ(0U, MainThreadDispatcher::GetInstance().GetStats().pending_high_water);
+}
+
+TEST_F(MainThreadDispatcherTest, WaitAndProcess_WakesOnEnqueue) {
+    std::atomic<bool> ran{false};
+    auto producer = std::async(std::launch::async, [&ran]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        MainThreadDispatcher::GetInstance().Enqueue([&ran]() { ran = true; });
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(1, MainThreadDispatcher::GetInstance().WaitAndProcess(5000));
+    EXPECT_TRUE(ran.load());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+    producer.wait();
+}
+
+TEST_F(MainThreadDispatcherTest, WaitAndProcess_TimesOutWhenIdle) {
+    EXPECT_EQ(0, MainThreadDispatcher::GetInstance().WaitAndProcess(10));
+}
+
+#ifndef _WIN32
+TEST_F(MainThreadDispatcherTest, GetEventFd_ReadableWhileCallbacksPending) {
+    const int fd = MainThreadDispatcher::GetInstance().GetEventFd();
+    if (fd < 0) {
+        GTEST_SKIP() << "no wakeup descriptor on this platform";
+    }
+    auto readable = [fd]() {
+        pollfd entry{fd, POLLIN, 0};
+        return poll(&entry, 1, 0) == 1;
+    };
+    EXPECT_FALSE(readable());
+
+    std::async(std::launch::async, []() {
+        for (int i = 0; i < 3; i++) {
+            MainThreadDispatcher::GetInstance().Enqueue([]() {});
+        }
+    }).wait();
+    EXPECT_TRUE(readable());
+
+    // Left-over work keeps the descriptor readable; an empty queue resets it
+    EXPECT_EQ(2, MainThreadDispatcher::GetInstance().ProcessQueue(2));
+    EXPECT_TRUE(readable());
+    EXPECT_EQ(1, MainThreadDispatcher::GetInstance().ProcessQueue());
+    EXPECT_FALSE(readable());
+}
+#endif
+
+TEST(UniqueCallbackTest, StoresSmallAndLargeCallables) {
+    int calls = 0;
+    UniqueCallback small([&calls]() { calls++; });
+    std::array<char, 128> large_state{};  // Too big for the inline buffer
+    large_state[0] = 1;
+    UniqueCallback large([&calls, large_state]() { calls += large_state[0]; });
+
+    large();
+    UniqueCallback moved = std::move(small);
+    EXPECT_FALSE(small);
+    ASSERT_TRUE(moved);
+    moved();
+    large = std::move(moved);
+    large();
+    EXPECT_EQ(3, calls);
+}
+
+TEST(UniqueCallbackTest, NullCallablesAreEmpty) {
+    EXPECT_FALSE(UniqueCallback(nullptr));
+    EXPECT_FALSE(UniqueCallback(std::function<void()>()));
+    void (*no_function)() = nullptr;
+    EXPECT_FALSE(UniqueCallback(no_function));
+}
+
+TEST(UniqueCallbackTest, DestroysCapturesOnce) {
+    auto token = std::make_shared<int>(0);
+    {
+        UniqueCallback first([token]() {});
+        UniqueCallback second(std::move(first));
+        EXPECT_EQ(2, token.use_count());
+    }
+    EXPECT_EQ(1, token.use_count());
+}
+
+namespace {
+
+struct TestNode {
+    int value;
+    TestNode* next;
+};
+
+}  // namespace
+
+TEST(MpscQueueTest, TakeAllReturnsPushOrderAndReportsEmptyTransition) {
+    MpscQueue<TestNode> queue;
+    TestNode nodes[3] = {{1, nullptr}, {2, nullptr}, {3, nullptr}};
+
+    EXPECT_TRUE(queue.Push(&nodes[0]));
+    EXPECT_FALSE(queue.Push(&nodes[1]));
+    EXPECT_FALSE(queue.Push(&nodes[2]));
+
+    std::vector<int> values;
+    for (TestNode* node = queue.TakeAll(); node; node = node->next) {
+        values.push_back(node->value);
+    }
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), values);
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_EQ(nullptr, queue.TakeAll());
+}
+
+TEST(MpscQueueTest, ConcurrentProducersLoseNothing) {
+    MpscQueue<TestNode> queue;
+    const int thread_count = 8;
+    const int pushes_per_thread = 1000;
+    std::vector<std::unique_ptr<TestNode[]>> storage;
+    for (int t = 0; t < thread_count; t++) {
+        storage.emplace_back(new TestNode[pushes_per_thread]);
+    }
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < thread_count; t++) {
+        producers.emplace_back([&queue, &storage, t]() {
+            for (int i = 0; i < pushes_per_thread; i++) {
+                storage[t][i].value = t * pushes_per_thread + i;
+                queue.Push(&storage[t][i]);
+            }
+        });
+    }
+
+    // Drain concurrently with the producers; each producer's nodes must come out in its own order
+    std::vector<int> last_seen(thread_count, -1);
+    int taken = 0;
+    while (taken < thread_count * pushes_per_thread) {
+        for (TestNode* node = queue.TakeAll(); node; node = node->next) {
+            const int producer = node->value / pushes_per_thread;
+            EXPECT_GT(node->value, last_seen[producer]);
+            last_seen[producer] = node->value;
+            taken++;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.Empty());
+}
+
 TEST_F(MainThreadDispatcherTest, IsMainThread_ReturnsFalse_OnBackgroundThread) {
     std::atomic<bool> is_main_thread{true};
 
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/protocol_messages.h"
+
+#include <string>
+#include <vector>
+
+using namespace croupier::sdk;
+using namespace croupier::sdk::protocol;
+
+static_assert(FindMsgInfo(MSG_INVOKE_REQUEST)->kind == MsgKind::REQUEST, "registry is usable at compile time");
+static_assert(std::is_same_v<MessageTraits<MSG_START_JOB_REQUEST>::Reply, v1::StartJobResponse>,
+              "StartJob replies with StartJobResponse");
+static_assert(MessageTraits<MSG_STREAM_JOB_REQUEST>::kReplyId == MSG_JOB_EVENT, "StreamJob replies with JobEvent");
+
+namespace {
+
+struct FakeProvider {
+    std::string last_cancelled;
+
+    v1::InvokeResponse handle(MsgTag<MSG_INVOKE_REQUEST>, const v1::InvokeRequest& request) {
+        v1::InvokeResponse response;
+        response.set_payload("invoked:" + request.function_id());
+        return response;
+    }
+
+    v1::StartJobResponse handle(MsgTag<MSG_START_JOB_REQUEST>, const v1::InvokeRequest& request) {
+        v1::StartJobResponse response;
+        response.set_job_id(request.function_id() + "-1");
+        return response;
+    }
+
+    void handle(MsgTag<MSG_CANCEL_JOB_REQUEST>, const v1::CancelJobRequest& request) {
+        last_cancelled = request.job_id();
+    }
+
+    std::vector<uint8_t> Route(uint32_t msg_id, const std::vector<uint8_t>& body) {
+        return DispatchAny<MSG_INVOKE_REQUEST, MSG_START_JOB_REQUEST, MSG_CANCEL_JOB_REQUEST>(
+            msg_id, body, [this](auto tag, const auto& request) { return handle(tag, request); });
+    }
+};
+
+}  // namespace
+
+TEST(ProtocolRegistryTest, NamesComeFromRegistry) {
+    EXPECT_EQ(MsgIDString(MSG_INVOKE_REQUEST), "InvokeRequest");
+    EXPECT_EQ(MsgIDString(MSG_JOB_EVENT), "JobEvent");
+    EXPECT_EQ(MsgIDString(MSG_REGISTER_CAPABILITIES_RESP), "RegisterCapabilitiesResponse");
+    EXPECT_EQ(MsgIDString(0xABCDEF), "Unknown(0xABCDEF)");
+    EXPECT_EQ(FindMsgInfo(0xABCDEF), nullptr);
+}
+
+TEST(ProtocolRegistryTest, RequestResponseClassification) {
+    EXPECT_TRUE(IsRequest(MSG_CANCEL_JOB_REQUEST));
+    EXPECT_TRUE(IsResponse(MSG_CANCEL_JOB_RESPONSE));
+    EXPECT_FALSE(IsRequest(MSG_JOB_EVENT));
+    EXPECT_FALSE(IsResponse(MSG_JOB_EVENT));
+    EXPECT_EQ(GetResponseMsgID(MSG_LIST_LOCAL_REQUEST), MSG_LIST_LOCAL_RESPONSE);
+}
+
+TEST(ProtocolRegistryTest, DispatchRoutesByMsgId) {
+    FakeProvider provider;
+    v1::InvokeRequest request;
+    request.set_function_id("wallet.get");
+    const std::vector<uint8_t> body = EncodeBody(request);
+
+    v1::InvokeResponse invoke_reply;
+    DecodeBody(MSG_INVOKE_RESPONSE, provider.Route(MSG_INVOKE_REQUEST, body), &invoke_reply);
+    EXPECT_EQ(invoke_reply.payload(), "invoked:wallet.get");
+
+    v1::StartJobResponse job_reply;
+    DecodeBody(MSG_START_JOB_RESPONSE, provider.Route(MSG_START_JOB_REQUEST, body), &job_reply);
+    EXPECT_EQ(job_reply.job_id(), "wallet.get-1");
+
+    v1::CancelJobRequest cancel;
+    cancel.set_job_id("job-7");
+    EXPECT_TRUE(provider.Route(MSG_CANCEL_JOB_REQUEST, EncodeBody(cancel)).empty());
+    EXPECT_EQ(provider.last_cancelled, "job-7");
+
+    EXPECT_THROW(provider.Route(MSG_LIST_LOCAL_REQUEST, {}), std::runtime_error);
+}
+
+TEST(ProtocolRegistryTest, DecodeFailureNamesTheMessage) {
+    const std::vector<uint8_t> garbage = {0xFF, 0xFF, 0xFF};
+    v1::InvokeResponse reply;
+    try {
+        DecodeBody(MSG_INVOKE_RESPONSE, garbage, &reply);
+        FAIL() << "expected a parse error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("InvokeResponse"), std::string::npos);
+    }
+}
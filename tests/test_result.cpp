@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/croupier_client.h"
+#include "croupier/sdk/result.h"
+
+#include <algorithm>
+#include <string>
+
+using namespace croupier::sdk;
+
+TEST(ResultTest, HoldsValue) {
+    Result<std::string> result(std::string("payload"));
+
+    ASSERT_TRUE(result.ok());
+    EXPECT_TRUE(static_cast<bool>(result));
+    EXPECT_EQ(result.value(), "payload");
+    EXPECT_EQ(result.value_or("fallback"), "payload");
+}
+
+TEST(ResultTest, HoldsErrorWithNumericCode) {
+    Result<std::string> result(Error(StatusCode::DEADLINE_EXCEEDED, "Timeout waiting for response"));
+
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code, StatusCode::DEADLINE_EXCEEDED);
+    EXPECT_EQ(result.error().Code(), 4);
+    EXPECT_EQ(result.error().ToString(), "DEADLINE_EXCEEDED: Timeout waiting for response");
+    EXPECT_EQ(result.value_or("fallback"), "fallback");
+}
+
+TEST(ResultTest, ValueThrowsErrorMessage) {
+    Result<std::string> result(Error(StatusCode::UNAVAILABLE, "Not connected"));
+
+    try {
+        (void)result.value();
+        FAIL() << "value() should throw on error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_STREQ(e.what(), "Not connected");
+    }
+}
+
+TEST(ResultTest, StatusCodesMatchDefaultRetryableCodes) {
+    EXPECT_EQ(static_cast<int>(StatusCode::UNAVAILABLE), 14);
+    EXPECT_EQ(static_cast<int>(StatusCode::INTERNAL), 13);
+    EXPECT_EQ(static_cast<int>(StatusCode::UNKNOWN), 2);
+    EXPECT_EQ(static_cast<int>(StatusCode::ABORTED), 10);
+    EXPECT_EQ(static_cast<int>(StatusCode::DEADLINE_EXCEEDED), 4);
+    EXPECT_STREQ(StatusCodeToString(StatusCode::RESOURCE_EXHAUSTED), "RESOURCE_EXHAUSTED");
+}
+
+TEST(ResultTest, DefaultRetryableCodesKeepUnknown) {
+    const RetryConfig retry;
+    const auto& codes = retry.retryable_status_codes;
+    EXPECT_EQ(std::count(codes.begin(), codes.end(), static_cast<int>(StatusCode::UNKNOWN)), 1);
+    EXPECT_EQ(std::count(codes.begin(), codes.end(), static_cast<int>(StatusCode::UNAVAILABLE)), 1);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/cache/result_cache.h"
+#include "test_clock.h"
+
+using namespace croupier::sdk;
+using namespace croupier::sdk::cache;
+using croupier::sdk::test::At;
+
+namespace {
+
+VirtualObjectDescriptor MakeWallet(const std::string& ttl_ms) {
+    VirtualObjectDescriptor desc;
+    desc.id = "wallet.entity";
+    desc.operations = {{"read", "wallet.get"}, {"update", "wallet.credit"}, {"delete", "wallet.close"}};
+    desc.metadata["cache_ttl_ms"] = ttl_ms;
+    return desc;
+}
+
+}  // namespace
+
+TEST(ResultCacheTest, CachesReadsUntilTTLExpires) {
+    ResultCacheConfig config;
+    config.enabled = true;
+    ResultCache cache(config);
+    cache.RegisterObject(MakeWallet("100"));
+
+    const std::string key = ResultCache::MakeKey("wallet.get", {}, R"({"id":1})");
+    uint64_t generation = 0;
+    EXPECT_FALSE(cache.Get("wallet.get", key, &generation, At(0)).has_value());
+    cache.Put("wallet.get", key, R"({"balance":5})", generation, At(0));
+
+    auto hit = cache.Get("wallet.get", key, &generation, At(50));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(*hit, R"({"balance":5})");
+    EXPECT_FALSE(cache.Get("wallet.get", key, &generation, At(100)).has_value());
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.hits, 1U);
+    EXPECT_EQ(stats.misses, 2U);
+}
+
+TEST(ResultCacheTest, KeyIncludesPayloadAndRoute) {
+    InvokeOptions hashed;
+    hashed.route = "hash";
+    hashed.hash_key = "player-1";
+
+    const std::string plain = ResultCache::MakeKey("wallet.get", {}, R"({"id":1})");
+    EXPECT_NE(plain, ResultCache::MakeKey("wallet.get", {}, R"({"id":2})"));
+    EXPECT_NE(plain, ResultCache::MakeKey("wallet.get", hashed, R"({"id":1})"));
+}
+
+TEST(ResultCacheTest, KeySeparatesCallersByMetadata) {
+    InvokeOptions alice;
+    alice.metadata = {{"authorization", "Bearer a"}, {"player_id", "alice"}};
+    InvokeOptions bob = alice;
+    bob.metadata["player_id"] = "bob";
+    InvokeOptions shifted;
+    shifted.metadata = {{"authorization", "Bearer aplayer_id"}, {"", "alice"}};
+
+    const std::string key = ResultCache::MakeKey("player.profile", alice, "{}");
+    EXPECT_EQ(key, ResultCache::MakeKey("player.profile", alice, "{}"));
+    EXPECT_NE(key, ResultCache::MakeKey("player.profile", bob, "{}"));
+    EXPECT_NE(key, ResultCache::MakeKey("player.profile", shifted, "{}"));
+    EXPECT_NE(key, ResultCache::MakeKey("player.profile", {}, "{}"));
+}
+
+TEST(ResultCacheTest, OversizedKeysAreNotCached) {
+    ResultCacheConfig config;
+    config.enabled = true;
+    config.max_value_bytes = 64;
+    ResultCache cache(config);
+    cache.SetFunctionTTL("config.items", 60000);
+
+    uint64_t generation = 0;
+    const std::string key = ResultCache::MakeKey("config.items", {}, std::string(100, 'x'));
+    cache.Put("config.items", key, "small", generation, At(0));
+    EXPECT_FALSE(cache.Get("config.items", key, &generation, At(1)).has_value());
+}
+
+TEST(ResultCacheTest, MutationOfSameObjectInvalidatesReads) {
+    ResultCacheConfig config;
+    config.enabled = true;
+    ResultCache cache(config);
+    cache.RegisterObject(MakeWallet("60000"));
+
+    const std::string key = ResultCache::MakeKey("wallet.get", {}, "{}");
+    uint64_t generation = 0;
+    cache.Get("wallet.get", key, &generation, At(0));
+    cache.Put("wallet.get", key, "old", generation, At(0));
+    ASSERT_TRUE(cache.Get("wallet.get", key, &generation, At(1)).has_value());
+
+    cache.OnInvoked("wallet.get");  // reads do not invalidate
+    ASSERT_TRUE(cache.Get("wallet.get", key, &generation, At(2)).has_value());
+
+    cache.OnInvoked("wallet.credit");
+    EXPECT_FALSE(cache.Get("wallet.get", key, &generation, At(3)).has_value());
+    EXPECT_EQ(cache.GetStats().invalidations, 1U);
+}
+
+TEST(ResultCacheTest, PutAfterConcurrentInvalidationIsDropped) {
+    ResultCacheConfig config;
+    config.enabled = true;
+    ResultCache cache(config);
+    cache.RegisterObject(MakeWallet("60000"));
+
+    const std::string key = ResultCache::MakeKey("wallet.get", {}, "{}");
+    uint64_t generation = 0;
+    cache.Get("wallet.get", key, &generation, At(0));
+    cache.OnInvoked("wallet.close");  // completes while the read is in flight
+    cache.Put("wallet.get", key, "stale", generation, At(1));
+
+    uint64_t next_generation = 0;
+    EXPECT_FALSE(cache.Get("wallet.get", key, &next_generation, At(2)).has_value());
+    EXPECT_NE(next_generation, generation);
+}
+
+TEST(ResultCacheTest, FunctionsWithoutTTLAreNotCached) {
+    ResultCacheConfig config;
+    config.enabled = true;
+    ResultCache cache(config);
+    cache.RegisterObject(MakeWallet("0"));
+
+    const std::string key = ResultCache::MakeKey("wallet.get", {}, "{}");
+    uint64_t generation = 0;
+    cache.Put("wallet.get", key, "value", generation, At(0));
+    EXPECT_FALSE(cache.Get("wallet.get", key, &generation, At(1)).has_value());
+
+    cache.SetFunctionTTL("player.profile", 1000);
+    const std::string profile_key = ResultCache::MakeKey("player.profile", {}, "{}");
+    cache.Get("player.profile", profile_key, &generation, At(0));
+    cache.Put("player.profile", profile_key, "profile", generation, At(0));
+    EXPECT_TRUE(cache.Get("player.profile", profile_key, &generation, At(1)).has_value());
+}
+
+TEST(ResultCacheTest, PerFunctionTTLOverridesObjectTTL) {
+    ResultCacheConfig config;
+    config.enabled = true;
+    ResultCache cache(config);
+    VirtualObjectDescriptor wallet = MakeWallet("60000");
+    wallet.metadata["cache_ttl_ms:wallet.get"] = "10";
+    cache.RegisterObject(wallet);
+
+    const std::string key = ResultCache::MakeKey("wallet.get", {}, "{}");
+    uint64_t generation = 0;
+    cache.Get("wallet.get", key, &generation, At(0));
+    cache.Put("wallet.get", key, "value", generation, At(0));
+    EXPECT_FALSE(cache.Get("wallet.get", key, &generation, At(20)).has_value());
+}
+
+TEST(ResultCacheTest, ClockEvictionBoundsEntriesAndKeepsReferencedOnes) {
+    ResultCacheConfig config;
+    config.enabled = true;
+    config.max_entries = 2;
+    config.shards = 1;
+    ResultCache cache(config);
+    cache.SetFunctionTTL("player.profile", 60000);
+
+    uint64_t generation = 0;
+    const std::string a = ResultCache::MakeKey("player.profile", {}, "a");
+    const std::string b = ResultCache::MakeKey("player.profile", {}, "b");
+    const std::string c = ResultCache::MakeKey("player.profile", {}, "c");
+    cache.Put("player.profile", a, "A", generation, At(0));
+    cache.Put("player.profile", b, "B", generation, At(0));
+    ASSERT_TRUE(cache.Get("player.profile", a, &generation, At(1)).has_value());  // second chance for a
+
+    cache.Put("player.profile", c, "C", generation, At(2));
+    EXPECT_TRUE(cache.Get("player.profile", a, &generation, At(3)).has_value());
+    EXPECT_FALSE(cache.Get("player.profile", b, &generation, At(3)).has_value());
+    EXPECT_TRUE(cache.Get("player.profile", c, &generation, At(3)).has_value());
+    EXPECT_EQ(cache.GetStats().evictions, 1U);
+}
+
+TEST(ResultCacheTest, DisabledCacheNeverStores) {
+    ResultCacheConfig config;
+    ResultCache cache(config);
+    cache.SetFunctionTTL("player.profile", 60000);
+
+    const std::string key = ResultCache::MakeKey("player.profile", {}, "{}");
+    uint64_t generation = 0;
+    cache.Put("player.profile", key, "value", generation, At(0));
+    EXPECT_FALSE(cache.Enabled());
+    EXPECT_FALSE(cache.Get("player.profile", key, &generation, At(1)).has_value());
+}
+
+TEST(ResultCacheTest, PerFunctionSizeLimit) {
+    ResultCacheConfig config;
+    config.enabled = true;
+    ResultCache cache(config);
+    cache.SetFunctionTTL("config.items", 60000, 8);
+
+    uint64_t generation = 0;
+    const std::string small = ResultCache::MakeKey("config.items", {}, "small");
+    const std::string large = ResultCache::MakeKey("config.items", {}, "large");
+    cache.Put("config.items", small, "12345678", generation, At(0));
+    cache.Put("config.items", large, "123456789", generation, At(0));
+    EXPECT_TRUE(cache.Get("config.items", small, &generation, At(1)).has_value());
+    EXPECT_FALSE(cache.Get("config.items", large, &generation, At(1)).has_value());
+}
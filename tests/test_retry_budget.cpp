@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/resilience/retry_budget.h"
+#include "test_clock.h"
+
+using namespace croupier::sdk;
+using namespace croupier::sdk::resilience;
+using croupier::sdk::test::At;
+
+TEST(RetryBudgetTest, MinimumRetriesAvailableWithoutTraffic) {
+    RetryBudgetConfig config;
+    config.enabled = true;
+    config.retry_ratio = 0.1;
+    config.min_retries_per_second = 2;
+    config.window_seconds = 5;
+    RetryBudget budget(config);
+
+    EXPECT_EQ(budget.Available(At(0)), 10);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(budget.TryAcquireRetry(At(0)));
+    }
+    EXPECT_FALSE(budget.TryAcquireRetry(At(0)));
+}
+
+TEST(RetryBudgetTest, SuccessesGrowTheBudgetByRatio) {
+    RetryBudgetConfig config;
+    config.enabled = true;
+    config.retry_ratio = 0.2;
+    config.min_retries_per_second = 0;
+    config.window_seconds = 10;
+    RetryBudget budget(config);
+
+    EXPECT_FALSE(budget.TryAcquireRetry(At(0)));
+    for (int i = 0; i < 50; ++i) {
+        budget.RecordSuccess(At(0));
+    }
+
+    EXPECT_EQ(budget.Available(At(0)), 10);
+    int granted = 0;
+    while (budget.TryAcquireRetry(At(1000))) {
+        ++granted;
+    }
+    EXPECT_EQ(granted, 10);
+}
+
+TEST(RetryBudgetTest, OldActivityLeavesTheWindow) {
+    RetryBudgetConfig config;
+    config.enabled = true;
+    config.retry_ratio = 1.0;
+    config.min_retries_per_second = 0;
+    config.window_seconds = 3;
+    RetryBudget budget(config);
+
+    for (int i = 0; i < 5; ++i) {
+        budget.RecordSuccess(At(0));
+    }
+    EXPECT_EQ(budget.Available(At(2000)), 5);
+    EXPECT_EQ(budget.Available(At(3000)), 0);
+
+    // Spent retries expire as well, restoring the floor.
+    RetryBudgetConfig floor_config;
+    floor_config.enabled = true;
+    floor_config.retry_ratio = 0.0;
+    floor_config.min_retries_per_second = 1;
+    floor_config.window_seconds = 2;
+    RetryBudget floor_budget(floor_config);
+    EXPECT_TRUE(floor_budget.TryAcquireRetry(At(0)));
+    EXPECT_TRUE(floor_budget.TryAcquireRetry(At(0)));
+    EXPECT_FALSE(floor_budget.TryAcquireRetry(At(1000)));
+    EXPECT_TRUE(floor_budget.TryAcquireRetry(At(2000)));
+}
+
+TEST(RetryBudgetTest, DisabledBudgetAlwaysAllowsRetries) {
+    RetryBudgetConfig config;  // enabled stays false; an enabled budget with these settings grants nothing
+    config.retry_ratio = 0.0;
+    config.min_retries_per_second = 0;
+    RetryBudget budget(config);
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(budget.TryAcquireRetry(At(0)));
+    }
+}
+
+TEST(RetryBudgetTest, InvokerConfigLeavesBudgetOptIn) {
+    InvokerConfig config;
+    EXPECT_FALSE(config.retry_budget.enabled);
+    EXPECT_GT(config.retry_budget.retry_ratio, 0.0);
+    EXPECT_FALSE(config.concurrency_limit.enabled);
+}
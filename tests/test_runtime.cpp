@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/croupier_client.h"
+#include "croupier/sdk/runtime.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace croupier::sdk;
+
+namespace {
+
+// Runs every task on one thread it owns, as an engine job system would
+class SingleThreadExecutor : public Executor {
+public:
+    SingleThreadExecutor() : thread_([this] { run(); }) {}
+
+    ~SingleThreadExecutor() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    void Post(Task task) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+    std::thread::id ThreadId() const { return thread_.get_id(); }
+
+    std::atomic<int> posted{0};
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            Task task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            posted++;
+            task();
+            lock.lock();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Task> tasks_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::seconds(2)) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(RuntimeTest, PostRunsTasksOnAFixedPool) {
+    RuntimeConfig config;
+    config.worker_threads = 2;
+    Runtime runtime(config);
+    EXPECT_EQ(runtime.ThreadCount(), 3U);
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    TaskGroup group;
+    for (int i = 0; i < 50; ++i) {
+        group.Post(runtime, [&] {
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        });
+    }
+    group.Wait();
+
+    EXPECT_LE(threads.size(), 2U);
+    EXPECT_EQ(threads.count(std::this_thread::get_id()), 0U);
+}
+
+TEST(RuntimeTest, InjectedExecutorRunsEverything) {
+    auto executor = std::make_shared<SingleThreadExecutor>();
+    RuntimeConfig config;
+    config.executor = executor;
+    Runtime runtime(config);
+    EXPECT_EQ(runtime.ThreadCount(), 1U);  // Only the reactor
+
+    std::promise<std::thread::id> ran_on;
+    runtime.ScheduleAfter(std::chrono::milliseconds(5), [&] { ran_on.set_value(std::this_thread::get_id()); });
+    auto future = ran_on.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_EQ(future.get(), executor->ThreadId());
+    runtime.Shutdown();
+}
+
+TEST(RuntimeTest, PeriodicTimerRepeatsUntilCancelled) {
+    Runtime runtime;
+    std::atomic<int> ticks{0};
+    const Runtime::SourceId timer = runtime.SchedulePeriodic(std::chrono::milliseconds(5), [&] { ticks++; });
+    ASSERT_TRUE(WaitFor([&] { return ticks >= 3; }));
+
+    runtime.Cancel(timer);
+    const int after_cancel = ticks;
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(ticks, after_cancel);
+}
+
+TEST(RuntimeTest, CancelWaitsForRunningCallback) {
+    Runtime runtime;
+    std::atomic<bool> started{false};
+    std::atomic<bool> finished{false};
+    const Runtime::SourceId timer = runtime.ScheduleAfter(std::chrono::milliseconds(0), [&] {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+    });
+    ASSERT_TRUE(WaitFor([&] { return started.load(); }));
+    runtime.Cancel(timer);
+    EXPECT_TRUE(finished);
+}
+
+TEST(RuntimeTest, TasksPostedDuringShutdownStillRun) {
+    RuntimeConfig config;
+    config.worker_threads = 2;
+    Runtime runtime(config);
+
+    TaskGroup group;
+    std::atomic<int> posted{0};
+    std::atomic<int> ran{0};
+    std::atomic<bool> stop_posting{false};
+    std::thread poster([&] {
+        while (!stop_posting) {
+            posted++;
+            group.Post(runtime, [&] { ran++; });
+            std::this_thread::yield();
+        }
+    });
+    ASSERT_TRUE(WaitFor([&] { return ran >= 10; }));
+
+    // Workers exit while the poster keeps going; nothing it posts may be stranded in the queue
+    runtime.Shutdown();
+    stop_posting = true;
+    poster.join();
+    auto waited = std::async(std::launch::async, [&] { group.Wait(); });
+    ASSERT_EQ(waited.wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_EQ(ran.load(), posted.load());
+}
+
+#ifndef _WIN32
+TEST(RuntimeTest, WatchReadableFiresWhenDescriptorIsReadable) {
+    Runtime runtime;
+    threading::WakeupFd source;
+    ASSERT_GE(source.Fd(), 0);
+
+    std::atomic<int> fired{0};
+    const Runtime::SourceId watch = runtime.WatchReadable(source.Fd(), [&] {
+        source.Clear();
+        fired++;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(fired, 0);
+
+    source.Notify();
+    ASSERT_TRUE(WaitFor([&] { return fired == 1; }));
+    source.Notify();
+    ASSERT_TRUE(WaitFor([&] { return fired == 2; }));
+    runtime.Cancel(watch);
+}
+#endif
+
+TEST(RuntimeTest, ClientsShareTheRuntimeThreads) {
+    auto runtime = std::make_shared<Runtime>();
+
+    ClientConfig config;
+    config.game_id = "runtime-test";
+    config.runtime = runtime;
+    config.disable_logging = true;
+    CroupierClient first(config);
+    CroupierClient second(config);
+
+    InvokerConfig invoker_config;
+    invoker_config.address = "127.0.0.1:19090";
+    invoker_config.runtime = runtime;
+    invoker_config.disable_logging = true;
+    CroupierInvoker invoker(invoker_config);
+
+    const std::string job_id = invoker.StartJob("missing.function", "{}");
+    auto events = invoker.StreamJob(job_id).get();
+    ASSERT_FALSE(events.empty());
+    EXPECT_TRUE(events.back().done);
+
+    EXPECT_EQ(runtime->ThreadCount(), 5U);
+    invoker.Close();
+    first.Close();
+    second.Close();
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/cache/result_cache.h"
+#include "croupier/sdk/cache/single_flight.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace croupier::sdk;
+using namespace croupier::sdk::cache;
+
+TEST(SingleFlightTest, ConcurrentCallersShareOneExecution) {
+    SingleFlight<std::string> flight;
+    std::atomic<int> executions{0};
+    std::atomic<int> shared_results{0};
+    std::atomic<bool> release{false};
+
+    auto slow_call = [&]() {
+        executions++;
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return std::string("config");
+    };
+
+    std::vector<std::thread> callers;
+    std::vector<std::string> results(8);
+    for (size_t i = 0; i < results.size(); ++i) {
+        callers.emplace_back([&, i]() {
+            bool shared = false;
+            results[i] = flight.Do("event.config", slow_call, &shared);
+            if (shared) {
+                shared_results++;
+            }
+        });
+    }
+
+    while (executions == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    release = true;
+    for (auto& caller : callers) {
+        caller.join();
+    }
+
+    EXPECT_EQ(executions.load(), 1);
+    EXPECT_EQ(shared_results.load(), 7);
+    for (const auto& result : results) {
+        EXPECT_EQ(result, "config");
+    }
+    EXPECT_EQ(flight.InFlight(), 0U);
+}
+
+TEST(SingleFlightTest, SequentialCallsExecuteAgain) {
+    SingleFlight<int> flight;
+    int executions = 0;
+
+    EXPECT_EQ(flight.Do("key", [&]() { return ++executions; }), 1);
+    EXPECT_EQ(flight.Do("key", [&]() { return ++executions; }), 2);
+    EXPECT_EQ(flight.Do("other", [&]() { return ++executions; }), 3);
+}
+
+TEST(SingleFlightTest, ExceptionsPropagateAndClearKey) {
+    SingleFlight<int> flight;
+
+    EXPECT_THROW(flight.Do("key", []() -> int { throw std::runtime_error("boom"); }), std::runtime_error);
+    EXPECT_EQ(flight.InFlight(), 0U);
+    EXPECT_EQ(flight.Do("key", []() { return 7; }), 7);
+}
+
+TEST(SingleFlightTest, CallersWithDifferentMetadataDoNotShare) {
+    SingleFlight<std::string> flight;
+    std::atomic<bool> release{false};
+    std::atomic<bool> started{false};
+
+    InvokeOptions alice;
+    alice.metadata["player_id"] = "alice";
+    InvokeOptions bob;
+    bob.metadata["player_id"] = "bob";
+
+    std::string alice_result;
+    std::thread first([&]() {
+        alice_result = flight.Do(ResultCache::MakeKey("player.profile", alice, "{}"), [&]() {
+            started = true;
+            while (!release) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return std::string("alice");
+        });
+    });
+    while (!started) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Alice's call is still in flight; Bob must run his own
+    bool shared = true;
+    EXPECT_EQ(flight.Do(ResultCache::MakeKey("player.profile", bob, "{}"), []() { return std::string("bob"); },
+                        &shared),
+              "bob");
+    EXPECT_FALSE(shared);
+
+    release = true;
+    first.join();
+    EXPECT_EQ(alice_result, "alice");
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/threading/dispatcher.h"
+#include "croupier/sdk/threading/strand.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace croupier::sdk;
+using namespace croupier::sdk::threading;
+
+namespace {
+
+// Wait until the counter reaches expected or two seconds pass
+bool WaitFor(const std::atomic<int>& counter, int expected) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (counter.load() < expected && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return counter.load() == expected;
+}
+
+}  // namespace
+
+TEST(DispatcherTest, InstancesAreBoundToTheirOwnThreads) {
+    Dispatcher shard;
+    std::atomic<bool> stop{false};
+    std::atomic<int> ran_on_shard{0};
+    std::promise<void> initialized;
+
+    std::thread shard_thread([&]() {
+        shard.Initialize();
+        initialized.set_value();
+        while (!stop.load()) {
+            shard.WaitAndProcess(10);
+        }
+    });
+    initialized.get_future().wait();
+
+    EXPECT_FALSE(shard.IsOwnerThread());
+    for (int i = 0; i < 10; i++) {
+        shard.Enqueue([&]() {
+            if (shard.IsOwnerThread()) {
+                ran_on_shard++;
+            }
+        });
+    }
+    EXPECT_TRUE(WaitFor(ran_on_shard, 10));
+
+    stop = true;
+    shard.Enqueue([]() {});
+    shard_thread.join();
+}
+
+TEST(StrandTest, RequiresAtLeastOneKeyedStrand) {
+    Runtime runtime;
+    EXPECT_THROW(KeyedStrands<int> strands(runtime, 0), std::runtime_error);
+}
+
+TEST(StrandTest, RunsCallbacksInOrderWithoutOverlap) {
+    Runtime runtime;
+    Strand strand(runtime);
+    std::vector<int> order;  // Touched only on the strand, so no lock
+    std::atomic<int> active{0};
+    std::atomic<int> overlaps{0};
+    std::atomic<int> done{0};
+
+    const int count = 500;
+    for (int i = 0; i < count; i++) {
+        strand.Post([&, i]() {
+            if (active.fetch_add(1) != 0) {
+                overlaps++;
+            }
+            EXPECT_TRUE(strand.RunningInThisThread());
+            order.push_back(i);
+            active--;
+            done++;
+        });
+    }
+
+    ASSERT_TRUE(WaitFor(done, count));
+    EXPECT_EQ(0, overlaps.load());
+    ASSERT_EQ(static_cast<size_t>(count), order.size());
+    for (int i = 0; i < count; i++) {
+        EXPECT_EQ(i, order[i]);
+    }
+    EXPECT_FALSE(strand.RunningInThisThread());
+}
+
+TEST(StrandTest, ConcurrentPostersKeepPerProducerOrder) {
+    Runtime runtime;
+    Strand strand(runtime);
+    const int producers = 4;
+    const int per_producer = 250;
+    std::vector<int> last_seen(producers, -1);
+    std::atomic<int> out_of_order{0};
+    std::atomic<int> done{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < per_producer; i++) {
+                strand.Post([&, p, i]() {
+                    if (i <= last_seen[p]) {
+                        out_of_order++;
+                    }
+                    last_seen[p] = i;
+                    done++;
+                });
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_TRUE(WaitFor(done, producers * per_producer));
+    EXPECT_EQ(0, out_of_order.load());
+}
+
+TEST(StrandTest, DifferentKeysRunInParallel) {
+    Runtime runtime(RuntimeConfig{2, nullptr});
+    KeyedStrands<int> strands(runtime, 2);
+    ASSERT_NE(&strands.StrandFor(0), &strands.StrandFor(1));
+
+    // Each key's callback waits for the other's; serialized execution would never finish
+    std::promise<void> first_started;
+    std::promise<void> second_started;
+    auto first = first_started.get_future().share();
+    auto second = second_started.get_future().share();
+    std::atomic<int> done{0};
+
+    strands.Post(0, [&]() {
+        first_started.set_value();
+        if (second.wait_for(std::chrono::seconds(2)) == std::future_status::ready) {
+            done++;
+        }
+    });
+    strands.Post(1, [&]() {
+        second_started.set_value();
+        if (first.wait_for(std::chrono::seconds(2)) == std::future_status::ready) {
+            done++;
+        }
+    });
+
+    EXPECT_TRUE(WaitFor(done, 2));
+}
+
+TEST(StrandTest, SameKeyRunsInOrder) {
+    Runtime runtime;
+    KeyedStrands<std::string> strands(runtime, 8);
+    std::vector<int> guild_events;
+    std::atomic<int> done{0};
+
+    for (int i = 0; i < 100; i++) {
+        strands.Post("guild-42", [&, i]() {
+            guild_events.push_back(i);
+            done++;
+        });
+    }
+
+    ASSERT_TRUE(WaitFor(done, 100));
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(i, guild_events[i]);
+    }
+}
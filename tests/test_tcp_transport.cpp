@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/tcp_transport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace croupier::sdk;
+
+namespace {
+
+// Minimal agent: accepts one connection and echoes every request frame after a fixed delay,
+// optionally writing each reply in two halves split_ms apart
+class DelayedEchoAgent {
+public:
+    explicit DelayedEchoAgent(int delay_ms, int split_ms = 0) : delay_ms_(delay_ms), split_ms_(split_ms) {
+        listen_socket_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(listen_socket_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listen_socket_, 1);
+        socklen_t length = sizeof(addr);
+        getsockname(listen_socket_, reinterpret_cast<sockaddr*>(&addr), &length);
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this]() { Serve(); });
+    }
+
+    ~DelayedEchoAgent() {
+        shutdown(listen_socket_, SHUT_RDWR);
+        if (client_socket_ != INVALID_SOCKET_VALUE) {
+            shutdown(client_socket_, SHUT_RDWR);
+        }
+        thread_.join();
+        closesocket(listen_socket_);
+        if (client_socket_ != INVALID_SOCKET_VALUE) {
+            closesocket(client_socket_);
+        }
+    }
+
+    int Port() const { return port_; }
+
+private:
+    void Serve() {
+        client_socket_ = accept(listen_socket_, nullptr, nullptr);
+        if (client_socket_ == INVALID_SOCKET_VALUE) {
+            return;
+        }
+        for (;;) {
+            uint8_t header[4];
+            if (!ReadAll(header, sizeof(header))) {
+                return;
+            }
+            const uint32_t size = (uint32_t(header[0]) << 24) | (uint32_t(header[1]) << 16) |
+                                  (uint32_t(header[2]) << 8) | uint32_t(header[3]);
+            std::vector<uint8_t> frame(sizeof(header) + size);
+            std::memcpy(frame.data(), header, sizeof(header));
+            if (!ReadAll(frame.data() + sizeof(header), size)) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms_));
+            size_t sent = 0;
+            if (split_ms_ > 0) {
+                sent = frame.size() / 2;
+                send(client_socket_, reinterpret_cast<const char*>(frame.data()), sent, MSG_NOSIGNAL);
+                std::this_thread::sleep_for(std::chrono::milliseconds(split_ms_));
+            }
+            send(client_socket_, reinterpret_cast<const char*>(frame.data() + sent), frame.size() - sent, MSG_NOSIGNAL);
+        }
+    }
+
+    bool ReadAll(uint8_t* buffer, size_t count) {
+        size_t offset = 0;
+        while (offset < count) {
+            const ssize_t n = recv(client_socket_, reinterpret_cast<char*>(buffer) + offset, count - offset, 0);
+            if (n <= 0) {
+                return false;
+            }
+            offset += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    int delay_ms_;
+    int split_ms_;
+    int port_ = 0;
+    socket_t listen_socket_ = INVALID_SOCKET_VALUE;
+    socket_t client_socket_ = INVALID_SOCKET_VALUE;
+    std::thread thread_;
+};
+
+void WaitForPending(const TCPTransport& transport, size_t count) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (transport.PendingCalls() < count && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+}  // namespace
+
+TEST(TCPTransportTest, CallReceivesResponse) {
+    DelayedEchoAgent agent(0);
+    TCPTransport transport("127.0.0.1", agent.Port(), 2000);
+    transport.Connect();
+
+    auto response = transport.TryCall(protocol::MSG_HEARTBEAT_LOCAL_REQUEST, {1, 2, 3});
+    ASSERT_TRUE(response.ok()) << response.error().ToString();
+    EXPECT_EQ(response.value().second, (std::vector<uint8_t>{1, 2, 3}));
+    EXPECT_EQ(transport.PendingCalls(), 0U);
+    transport.Close();
+}
+
+TEST(TCPTransportTest, CallBatchReturnsResponsesInRequestOrder) {
+    DelayedEchoAgent agent(0);
+    TCPTransport transport("127.0.0.1", agent.Port(), 2000);
+    transport.Connect();
+
+    auto results = transport.TryCallBatch({{protocol::MSG_HEARTBEAT_LOCAL_REQUEST, {1}},
+                                           {protocol::MSG_HEARTBEAT_LOCAL_REQUEST, {2, 2}},
+                                           {protocol::MSG_HEARTBEAT_LOCAL_REQUEST, {}}});
+    ASSERT_EQ(results.size(), 3U);
+    for (const auto& result : results) {
+        ASSERT_TRUE(result.ok()) << result.error().ToString();
+    }
+    EXPECT_EQ(results[0].value().second, std::vector<uint8_t>{1});
+    EXPECT_EQ(results[1].value().second, (std::vector<uint8_t>{2, 2}));
+    EXPECT_TRUE(results[2].value().second.empty());
+    EXPECT_EQ(transport.PendingCalls(), 0U);
+    transport.Close();
+}
+
+TEST(TCPTransportTest, CloseFailsPendingCalls) {
+    DelayedEchoAgent agent(1000);
+    TCPTransport transport("127.0.0.1", agent.Port(), 5000);
+    transport.Connect();
+
+    auto call = std::async(std::launch::async, [&]() { return transport.TryCall(protocol::MSG_INVOKE_REQUEST, {7}); });
+    WaitForPending(transport, 1);
+    EXPECT_EQ(transport.PendingCalls(), 1U);
+    transport.Close();
+
+    auto result = call.get();
+    ASSERT_FALSE(result.ok());
+    EXPECT_EQ(result.error().code, StatusCode::UNAVAILABLE);
+}
+
+TEST(TCPTransportTest, PolledModeReadsResponsesOnTheCallingThread) {
+    DelayedEchoAgent agent(10);
+    TCPTransport transport("127.0.0.1", agent.Port(), 2000);
+    transport.SetPolled(true);
+    transport.Connect();
+    EXPECT_NE(transport.Fd(), INVALID_SOCKET_VALUE);
+
+    auto response = transport.TryCall(protocol::MSG_INVOKE_REQUEST, {4, 2});
+    ASSERT_TRUE(response.ok()) << response.error().ToString();
+    EXPECT_EQ(response.value().second, (std::vector<uint8_t>{4, 2}));
+    EXPECT_EQ(transport.ProcessIncoming(), 0);
+    transport.Close();
+}
+
+TEST(TCPTransportTest, PolledProcessIncomingBuffersPartialFrames) {
+    DelayedEchoAgent agent(0, 200);
+    TCPTransport transport("127.0.0.1", agent.Port(), 2000);
+    transport.SetPolled(true);
+    transport.Connect();
+
+    std::atomic<bool> replied{false};
+    std::vector<uint8_t> body;
+    auto sent = transport.CallAsync(protocol::MSG_HEARTBEAT_LOCAL_REQUEST, {9, 8, 7, 6},
+                                    [&](Result<std::pair<uint32_t, std::vector<uint8_t>>> reply) {
+                                        ASSERT_TRUE(reply.ok()) << reply.error().ToString();
+                                        body = reply.value().second;
+                                        replied = true;
+                                    });
+    ASSERT_TRUE(sent.ok());
+    EXPECT_EQ(transport.PendingCalls(), 0U);
+
+    // Half the reply arrives first; no ProcessIncoming call may wait for the rest
+    auto slowest = std::chrono::steady_clock::duration::zero();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!replied && std::chrono::steady_clock::now() < deadline) {
+        const auto start = std::chrono::steady_clock::now();
+        transport.ProcessIncoming();
+        slowest = std::max(slowest, std::chrono::steady_clock::now() - start);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(replied);
+    EXPECT_EQ(body, (std::vector<uint8_t>{9, 8, 7, 6}));
+    EXPECT_LT(slowest, std::chrono::milliseconds(100));
+    transport.Close();
+}
+
+TEST(TCPTransportTest, CallAsyncFailsOverdueAndClosedRequests) {
+    DelayedEchoAgent agent(500);
+    TCPTransport transport("127.0.0.1", agent.Port(), 50);
+    transport.SetPolled(true);
+    transport.Connect();
+
+    std::vector<StatusCode> failures;
+    auto on_reply = [&](Result<std::pair<uint32_t, std::vector<uint8_t>>> reply) {
+        ASSERT_FALSE(reply.ok());
+        failures.push_back(reply.error().code);
+    };
+    ASSERT_TRUE(transport.CallAsync(protocol::MSG_HEARTBEAT_LOCAL_REQUEST, {1}, on_reply).ok());
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    transport.ProcessIncoming();
+    ASSERT_EQ(failures.size(), 1U);
+    EXPECT_EQ(failures[0], StatusCode::DEADLINE_EXCEEDED);
+
+    ASSERT_TRUE(transport.CallAsync(protocol::MSG_HEARTBEAT_LOCAL_REQUEST, {2}, on_reply).ok());
+    transport.Close();
+    ASSERT_EQ(failures.size(), 2U);
+    EXPECT_EQ(failures[1], StatusCode::UNAVAILABLE);
+}
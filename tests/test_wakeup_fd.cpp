@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "croupier/sdk/threading/wakeup_fd.h"
+
+#include <chrono>
+#include <thread>
+
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
+using namespace croupier::sdk::threading;
+
+namespace {
+
+#ifndef _WIN32
+bool Readable(int fd) {
+    pollfd entry{};
+    entry.fd = fd;
+    entry.events = POLLIN;
+    return poll(&entry, 1, 0) > 0;
+}
+#endif
+
+}  // namespace
+
+TEST(WakeupFdTest, NotifyMakesFdReadableUntilClear) {
+    WakeupFd wakeup;
+    EXPECT_FALSE(wakeup.Pending());
+#ifndef _WIN32
+    ASSERT_GE(wakeup.Fd(), 0);
+    EXPECT_FALSE(Readable(wakeup.Fd()));
+#endif
+
+    wakeup.Notify();
+    wakeup.Notify();  // coalesced
+    EXPECT_TRUE(wakeup.Pending());
+#ifndef _WIN32
+    EXPECT_TRUE(Readable(wakeup.Fd()));
+#endif
+
+    wakeup.Clear();
+    EXPECT_FALSE(wakeup.Pending());
+#ifndef _WIN32
+    EXPECT_FALSE(Readable(wakeup.Fd()));
+#endif
+}
+
+TEST(WakeupFdTest, WaitReturnsOnNotifyOrTimeout) {
+    WakeupFd wakeup;
+    EXPECT_FALSE(wakeup.Wait(10));
+
+    std::thread notifier([&wakeup]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        wakeup.Notify();
+    });
+    EXPECT_TRUE(wakeup.Wait(5000));
+    notifier.join();
+    EXPECT_TRUE(wakeup.Wait(0));  // Wait does not consume the notification
+}